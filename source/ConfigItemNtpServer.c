@@ -1,6 +1,6 @@
 #include "ConfigItemNtpServer.h"
+#include "arena.h"
 #include "kbd.h"
-#include <coreinit/memdefaultheap.h>
 #include <string.h>
 #include <wups.h>
 
@@ -26,7 +26,7 @@ bool WUPSConfigItemNtpServer_callCallback(void *context) {
 void WUPSConfigItemNtpServer_onButtonPressed(void *context, WUPSConfigButtons buttons) {
     ConfigItemNtpServer *item = (ConfigItemNtpServer *) context;
     if(buttons & WUPS_CONFIG_BUTTON_A)
-        renderKeyboard(item->value);
+        renderKeyboard(item->value, MAX_NTP_SERVER_LENTGH, item->defaultValue);
 }
 
 bool WUPSConfigItemNtpServer_isMovementAllowed(void *context) {
@@ -36,11 +36,11 @@ bool WUPSConfigItemNtpServer_isMovementAllowed(void *context) {
 
 void WUPSConfigItemNtpServer_restoreDefault(void *context) {
     ConfigItemNtpServer *item  = (ConfigItemNtpServer *) context;
-    strcpy(item->value, "pool.ntp.org");
+    strcpy(item->value, item->defaultValue);
 }
 
 void WUPSConfigItemNtpServer_onDelete(void *context) {
-    MEMFreeToDefaultHeap(context);
+    arenaFree(ARENA_POOL_CONFIG_ITEM_NTP_SERVER, context);
 }
 
 void WUPSConfigItemNtpServer_onSelected(void *context, bool isSelected) {
@@ -48,15 +48,16 @@ void WUPSConfigItemNtpServer_onSelected(void *context, bool isSelected) {
     (void)isSelected;
 }
 
-bool WUPSConfigItemNtpServer_AddToCategory(WUPSConfigCategoryHandle cat, const char *configId, const char *displayName, char *value, NtpServerValueChangedCallback callback) {
+bool WUPSConfigItemNtpServer_AddToCategory(WUPSConfigCategoryHandle cat, const char *configId, const char *displayName, char *value, const char *defaultValue, NtpServerValueChangedCallback callback) {
     if (cat == 0)
         return false;
 
-    ConfigItemNtpServer *item = (ConfigItemNtpServer *) MEMAllocFromDefaultHeap(sizeof(ConfigItemNtpServer));
+    ConfigItemNtpServer *item = (ConfigItemNtpServer *) arenaAlloc(ARENA_POOL_CONFIG_ITEM_NTP_SERVER);
     if (item == NULL)
         return false;
 
     item->value = value;
+    item->defaultValue = defaultValue;
     item->callback = callback;
 
     WUPSConfigCallbacks_t callbacks = {
@@ -70,7 +71,7 @@ bool WUPSConfigItemNtpServer_AddToCategory(WUPSConfigCategoryHandle cat, const c
             .onDelete                       = &WUPSConfigItemNtpServer_onDelete};
 
     if (WUPSConfigItem_Create(&(item->handle), configId, displayName, callbacks, item) < 0) {
-        MEMFreeToDefaultHeap(item);
+        arenaFree(ARENA_POOL_CONFIG_ITEM_NTP_SERVER, item);
         return false;
     };
 
@@ -12,14 +12,15 @@ typedef void (*NtpServerValueChangedCallback)();
 typedef struct ConfigItemNtpServer {
     WUPSConfigItemHandle handle;
     char *value;
+    const char *defaultValue;
     NtpServerValueChangedCallback callback;
 } ConfigItemNtpServer;
 
-bool WUPSConfigItemNtpServer_AddToCategory(WUPSConfigCategoryHandle cat, const char *configId, const char *displayName, char *value, NtpServerValueChangedCallback callback);
+bool WUPSConfigItemNtpServer_AddToCategory(WUPSConfigCategoryHandle cat, const char *configId, const char *displayName, char *value, const char *defaultValue, NtpServerValueChangedCallback callback);
 
-#define WUPSConfigItemNtpServer_AddToCategoryHandled(__config__, __cat__, __configId__, __displayName__, __value__, __callback__)    \
+#define WUPSConfigItemNtpServer_AddToCategoryHandled(__config__, __cat__, __configId__, __displayName__, __value__, __default__, __callback__)   \
     do {                                                                                                                                    \
-        if (!WUPSConfigItemNtpServer_AddToCategory(__cat__, __configId__, __displayName__, __value__, __callback__)) {               \
+        if (!WUPSConfigItemNtpServer_AddToCategory(__cat__, __configId__, __displayName__, __value__, __default__, __callback__)) {  \
             WUPSConfig_Destroy(__config__);                                                                                                 \
             return 0;                                                                                                                       \
         }                                                                                                                                   \
@@ -1,7 +1,7 @@
 #include "ConfigItemTime.h"
+#include "arena.h"
 #include <coreinit/atomic.h>
 #include <coreinit/memory.h>
-#include <coreinit/memdefaultheap.h>
 #include <wups.h>
 
 void WUPSConfigItemTime_onDelete(void *context);
@@ -44,7 +44,7 @@ ConfigItemTime *WUPSConfigItemTime_AddToCategoryEx(WUPSConfigCategoryHandle cat,
     if(cat == 0)
         return NULL;
 
-    ConfigItemTime *item = (ConfigItemTime *) MEMAllocFromDefaultHeap(sizeof(ConfigItemTime));
+    ConfigItemTime *item = (ConfigItemTime *) arenaAlloc(ARENA_POOL_CONFIG_ITEM_TIME);
     if(item == NULL)
         return NULL;
 
@@ -62,7 +62,7 @@ ConfigItemTime *WUPSConfigItemTime_AddToCategoryEx(WUPSConfigCategoryHandle cat,
             .onDelete                       = &WUPSConfigItemTime_onDelete};
 
     if(WUPSConfigItem_Create(&item->handle, configID, displayName, callbacks, item) < 0) {
-        MEMFreeToDefaultHeap(item);
+        arenaFree(ARENA_POOL_CONFIG_ITEM_TIME, item);
         return NULL;
     }
 
@@ -75,7 +75,7 @@ ConfigItemTime *WUPSConfigItemTime_AddToCategoryEx(WUPSConfigCategoryHandle cat,
 }
 
 void WUPSConfigItemTime_onDelete(void *context) {
-    MEMFreeToDefaultHeap(context);
+    arenaFree(ARENA_POOL_CONFIG_ITEM_TIME, context);
 }
 
 ConfigItemTime *WUPSConfigItemTime_AddToCategory(WUPSConfigCategoryHandle cat, const char *configID, const char *displayName, volatile uint32_t *ap, uint32_t mask) {
@@ -0,0 +1,114 @@
+#include "ConfigItemTimezone.h"
+#include "arena.h"
+#include "kbd.h"
+#include "settings.h"
+#include "tzdb.h"
+#include <stdio.h>
+#include <string.h>
+#include <wups.h>
+
+int32_t WUPSConfigItemTimezone_getCurrentValueDisplay(void *context, char *out_buf, int32_t out_size) {
+    ConfigItemTimezone *item = (ConfigItemTimezone *) context;
+    snprintf(out_buf, out_size, "%s", tzdbName(tzdbSortedZone(item->position)));
+    return 0;
+}
+
+int32_t WUPSConfigItemTimezone_getCurrentValueSelectedDisplay(void *context, char *out_buf, int32_t out_size) {
+    ConfigItemTimezone *item = (ConfigItemTimezone *) context;
+    snprintf(out_buf, out_size, "<%s>", tzdbName(tzdbSortedZone(item->position)));
+    return 0;
+}
+
+bool WUPSConfigItemTimezone_callCallback(void *context) {
+    ConfigItemTimezone *item = (ConfigItemTimezone *) context;
+    uint32_t zone = tzdbSortedZone(item->position);
+    if(item->callback != NULL && zone != item->valueAtCreation)
+    {
+        item->callback(item, zone);
+        return true;
+    }
+
+    return false;
+}
+
+void WUPSConfigItemTimezone_onButtonPressed(void *context, WUPSConfigButtons buttons) {
+    ConfigItemTimezone *item = (ConfigItemTimezone *) context;
+    uint32_t region = tzdbRegionOf(item->position);
+
+    if(buttons & WUPS_CONFIG_BUTTON_LEFT)
+        item->position = item->position == 0 ? TZDB_ZONE_COUNT - 1 : item->position - 1;
+    else if(buttons & WUPS_CONFIG_BUTTON_RIGHT)
+        item->position = item->position == TZDB_ZONE_COUNT - 1 ? 0 : item->position + 1;
+    else if(buttons & WUPS_CONFIG_BUTTON_L)
+    {
+        // Back to the start of the region first, like the previous track button of a music player
+        if(item->position == tzdbRegionStart(region))
+            region = region == 0 ? TZDB_REGION_COUNT - 1 : region - 1;
+
+        item->position = tzdbRegionStart(region);
+    }
+    else if(buttons & WUPS_CONFIG_BUTTON_R)
+        item->position = tzdbRegionStart(region == TZDB_REGION_COUNT - 1 ? 0 : region + 1);
+    else if(buttons & WUPS_CONFIG_BUTTON_A)
+    {
+        char search[TZDB_NAME_MAX] = "";
+        renderKeyboard(search, sizeof(search), "");
+
+        int32_t zone = tzdbSearch(search);
+        if(zone >= 0)
+            item->position = tzdbSortedPosition(zone);
+    }
+}
+
+bool WUPSConfigItemTimezone_isMovementAllowed(void *context) {
+    (void)context;
+    return true;
+}
+
+void WUPSConfigItemTimezone_restoreDefault(void *context) {
+    ConfigItemTimezone *item = (ConfigItemTimezone *) context;
+    item->position = tzdbSortedPosition(DEFAULT_TIMEZONE);
+}
+
+void WUPSConfigItemTimezone_onDelete(void *context) {
+    arenaFree(ARENA_POOL_CONFIG_ITEM_TIMEZONE, context);
+}
+
+void WUPSConfigItemTimezone_onSelected(void *context, bool isSelected) {
+    (void)context;
+    (void)isSelected;
+}
+
+bool WUPSConfigItemTimezone_AddToCategory(WUPSConfigCategoryHandle cat, const char *configId, const char *displayName, uint32_t zone, TimezoneValueChangedCallback callback) {
+    if (cat == 0 || zone >= TZDB_ZONE_COUNT)
+        return false;
+
+    ConfigItemTimezone *item = (ConfigItemTimezone *) arenaAlloc(ARENA_POOL_CONFIG_ITEM_TIMEZONE);
+    if (item == NULL)
+        return false;
+
+    item->position = tzdbSortedPosition(zone);
+    item->valueAtCreation = zone;
+    item->callback = callback;
+
+    WUPSConfigCallbacks_t callbacks = {
+            .getCurrentValueDisplay         = &WUPSConfigItemTimezone_getCurrentValueDisplay,
+            .getCurrentValueSelectedDisplay = &WUPSConfigItemTimezone_getCurrentValueSelectedDisplay,
+            .onSelected                     = &WUPSConfigItemTimezone_onSelected,
+            .restoreDefault                 = &WUPSConfigItemTimezone_restoreDefault,
+            .isMovementAllowed              = &WUPSConfigItemTimezone_isMovementAllowed,
+            .callCallback                   = &WUPSConfigItemTimezone_callCallback,
+            .onButtonPressed                = &WUPSConfigItemTimezone_onButtonPressed,
+            .onDelete                       = &WUPSConfigItemTimezone_onDelete};
+
+    if (WUPSConfigItem_Create(&(item->handle), configId, displayName, callbacks, item) < 0) {
+        arenaFree(ARENA_POOL_CONFIG_ITEM_TIMEZONE, item);
+        return false;
+    }
+
+    if (WUPSConfigCategory_AddItem(cat, item->handle) < 0) {
+        WUPSConfigItem_Destroy(item->handle);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <wups.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ConfigItemTimezone ConfigItemTimezone;
+typedef void (*TimezoneValueChangedCallback)(ConfigItemTimezone *, uint32_t);
+
+// Picks a zone of the timezone database: left/right step through the zones sorted by name, L/R jump to the
+// previous/next region and A opens the keyboard to search for a city or zone name.
+struct ConfigItemTimezone {
+    WUPSConfigItemHandle handle;
+    uint32_t position;        // Position of the selected zone in the sorted zones
+    uint32_t valueAtCreation; // Zone selected when the menu opened
+    TimezoneValueChangedCallback callback;
+};
+
+bool WUPSConfigItemTimezone_AddToCategory(WUPSConfigCategoryHandle cat, const char *configId, const char *displayName, uint32_t zone, TimezoneValueChangedCallback callback);
+
+#define WUPSConfigItemTimezone_AddToCategoryHandled(__config__, __cat__, __configId__, __displayName__, __zone__, __callback__)   \
+    do {                                                                                                                       \
+        if (!WUPSConfigItemTimezone_AddToCategory(__cat__, __configId__, __displayName__, __zone__, __callback__)) {           \
+            WUPSConfig_Destroy(__config__);                                                                                    \
+            return 0;                                                                                                          \
+        }                                                                                                                      \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,128 @@
+#include "arena.h"
+#include "ConfigItemNtpServer.h"
+#include "ConfigItemTimezone.h"
+#include "ConfigItemTime.h"
+#include <coreinit/atomic.h>
+#include <coreinit/debug.h>
+#include <coreinit/memory.h>
+#include <coreinit/thread.h>
+
+#define ARENA_ALIGN(x) (((x) + 15) & ~15)
+
+#define ARENA_THREAD_SIZE ARENA_ALIGN(ARENA_ALIGN(sizeof(OSThread)) + ARENA_THREAD_STACK_SIZE)
+#define ARENA_CONFIG_ITEM_TIME_SIZE ARENA_ALIGN(sizeof(ConfigItemTime))
+#define ARENA_CONFIG_ITEM_NTP_SERVER_SIZE ARENA_ALIGN(sizeof(ConfigItemNtpServer))
+#define ARENA_CONFIG_ITEM_TIMEZONE_SIZE ARENA_ALIGN(sizeof(ConfigItemTimezone))
+
+#define ARENA_THREAD_COUNT 1
+#define ARENA_CONFIG_ITEM_TIME_COUNT 3
+#define ARENA_CONFIG_ITEM_NTP_SERVER_COUNT 2
+#define ARENA_CONFIG_ITEM_TIMEZONE_COUNT 1
+#define ARENA_GLYPH_ATLAS_COUNT 1
+#define ARENA_KEYBOARD_LAYER_COUNT 1
+#define ARENA_TZIF_COUNT 1
+
+#define ARENA_THREAD_OFFSET 0
+#define ARENA_CONFIG_ITEM_TIME_OFFSET (ARENA_THREAD_OFFSET + (ARENA_THREAD_SIZE * ARENA_THREAD_COUNT))
+#define ARENA_CONFIG_ITEM_NTP_SERVER_OFFSET (ARENA_CONFIG_ITEM_TIME_OFFSET + (ARENA_CONFIG_ITEM_TIME_SIZE * ARENA_CONFIG_ITEM_TIME_COUNT))
+#define ARENA_CONFIG_ITEM_TIMEZONE_OFFSET (ARENA_CONFIG_ITEM_NTP_SERVER_OFFSET + (ARENA_CONFIG_ITEM_NTP_SERVER_SIZE * ARENA_CONFIG_ITEM_NTP_SERVER_COUNT))
+#define ARENA_GLYPH_ATLAS_OFFSET (ARENA_CONFIG_ITEM_TIMEZONE_OFFSET + (ARENA_CONFIG_ITEM_TIMEZONE_SIZE * ARENA_CONFIG_ITEM_TIMEZONE_COUNT))
+#define ARENA_KEYBOARD_LAYER_OFFSET (ARENA_GLYPH_ATLAS_OFFSET + (ARENA_GLYPH_ATLAS_SIZE * ARENA_GLYPH_ATLAS_COUNT))
+#define ARENA_TZIF_OFFSET (ARENA_KEYBOARD_LAYER_OFFSET + (ARENA_KEYBOARD_LAYER_SIZE * ARENA_KEYBOARD_LAYER_COUNT))
+#define ARENA_SIZE (ARENA_TZIF_OFFSET + (ARENA_TZIF_SIZE * ARENA_TZIF_COUNT))
+
+typedef struct
+{
+    const char *name;
+    uint32_t offset;
+    uint32_t blockSize;
+    uint32_t blockCount;
+} ArenaPoolInfo;
+
+static const ArenaPoolInfo pools[ARENA_POOL_COUNT] = {
+    [ARENA_POOL_THREAD]                 = { "Thread", ARENA_THREAD_OFFSET, ARENA_THREAD_SIZE, ARENA_THREAD_COUNT },
+    [ARENA_POOL_CONFIG_ITEM_TIME]       = { "ConfigItemTime", ARENA_CONFIG_ITEM_TIME_OFFSET, ARENA_CONFIG_ITEM_TIME_SIZE, ARENA_CONFIG_ITEM_TIME_COUNT },
+    [ARENA_POOL_CONFIG_ITEM_NTP_SERVER] = { "ConfigItemNtpServer", ARENA_CONFIG_ITEM_NTP_SERVER_OFFSET, ARENA_CONFIG_ITEM_NTP_SERVER_SIZE, ARENA_CONFIG_ITEM_NTP_SERVER_COUNT },
+    [ARENA_POOL_CONFIG_ITEM_TIMEZONE]   = { "ConfigItemTimezone", ARENA_CONFIG_ITEM_TIMEZONE_OFFSET, ARENA_CONFIG_ITEM_TIMEZONE_SIZE, ARENA_CONFIG_ITEM_TIMEZONE_COUNT },
+    [ARENA_POOL_GLYPH_ATLAS]            = { "Glyph atlas", ARENA_GLYPH_ATLAS_OFFSET, ARENA_GLYPH_ATLAS_SIZE, ARENA_GLYPH_ATLAS_COUNT },
+    [ARENA_POOL_KEYBOARD_LAYER]         = { "Keyboard layer", ARENA_KEYBOARD_LAYER_OFFSET, ARENA_KEYBOARD_LAYER_SIZE, ARENA_KEYBOARD_LAYER_COUNT },
+    [ARENA_POOL_TZIF]                   = { "TZif", ARENA_TZIF_OFFSET, ARENA_TZIF_SIZE, ARENA_TZIF_COUNT },
+};
+
+_Static_assert(ARENA_THREAD_COUNT <= 32 && ARENA_CONFIG_ITEM_TIME_COUNT <= 32 && ARENA_CONFIG_ITEM_NTP_SERVER_COUNT <= 32 && ARENA_CONFIG_ITEM_TIMEZONE_COUNT <= 32 && ARENA_GLYPH_ATLAS_COUNT <= 32 && ARENA_KEYBOARD_LAYER_COUNT <= 32 && ARENA_TZIF_COUNT <= 32, "Pools are limited to 32 blocks");
+
+static uint8_t arena[ARENA_SIZE] __attribute__((aligned(16)));
+// One bit per block, set while in use
+static volatile uint32_t usedBlocks[ARENA_POOL_COUNT];
+static ArenaStats stats[ARENA_POOL_COUNT];
+
+void arenaInit(void)
+{
+    OSBlockSet((void *)usedBlocks, 0, sizeof(usedBlocks));
+    OSBlockSet(stats, 0, sizeof(stats));
+}
+
+void *arenaAlloc(ArenaPool pool)
+{
+    const ArenaPoolInfo *info = &pools[pool];
+    uint32_t used;
+    uint32_t block;
+
+    // Lock free, so it's safe from the config menu and the worker at the same time
+    do
+    {
+        used = usedBlocks[pool];
+        for(block = 0; block < info->blockCount; ++block)
+            if(!(used & (1 << block)))
+                break;
+
+        if(block == info->blockCount)
+        {
+            OSAddAtomic(&stats[pool].failures, 1);
+            return NULL;
+        }
+    } while(!OSCompareAndSwapAtomic(&usedBlocks[pool], used, used | (1 << block)));
+
+    OSAddAtomic(&stats[pool].allocs, 1);
+    used = (uint32_t)(OSAddAtomic(&stats[pool].used, 1) + 1);
+
+    // Raise the high water mark without losing a higher value another thread stored meanwhile
+    uint32_t highWater;
+    do
+    {
+        highWater = stats[pool].highWater;
+        if(used <= highWater)
+            break;
+    } while(!OSCompareAndSwapAtomic(&stats[pool].highWater, highWater, used));
+
+    return arena + info->offset + (block * info->blockSize);
+}
+
+void arenaFree(ArenaPool pool, void *ptr)
+{
+    if(ptr == NULL)
+        return;
+
+    const ArenaPoolInfo *info = &pools[pool];
+    uint32_t block = ((uint8_t *)ptr - (arena + info->offset)) / info->blockSize;
+
+    OSAddAtomic(&stats[pool].used, -1);
+    OSAndAtomic(&usedBlocks[pool], ~(1 << block));
+}
+
+uint32_t arenaBlockSize(ArenaPool pool)
+{
+    return pools[pool].blockSize;
+}
+
+const ArenaStats *arenaGetStats(ArenaPool pool)
+{
+    return &stats[pool];
+}
+
+void arenaReport(void)
+{
+    OSReport("SNTP Client: Arena of %u bytes\n", ARENA_SIZE);
+    for(uint32_t i = 0; i < ARENA_POOL_COUNT; ++i)
+        OSReport("SNTP Client: Pool %s: %d/%u used, high water %u, %d allocs, %d failures\n", pools[i].name, stats[i].used, pools[i].blockCount, stats[i].highWater, stats[i].allocs, stats[i].failures);
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <wut.h>
+
+// Static memory for everything the plugin used to allocate from the default heap, which belongs to the
+// running title. Each kind of object has its own pool of fixed size blocks, so the worst case footprint
+// is known at compile time (see ARENA_SIZE) and the titles heap never gets fragmented by the plugin:
+//
+// Pool              Blocks  Block size
+// Worker thread     1       sizeof(OSThread) + 8 KiB stack (~9.7 KiB)
+// ConfigItemTime    3       sizeof(ConfigItemTime)
+// ConfigItemNtpSrv  2       sizeof(ConfigItemNtpServer)
+// ConfigItemTz      1       sizeof(ConfigItemTimezone)
+// Glyph atlas       1       32 KiB, glyph bitmaps of the keyboard renderer
+// Keyboard layer    1       93 KiB, pre-rendered key grid of the keyboard renderer
+// TZif file         1       8 KiB, zone data loaded from the SD card
+//
+// Total is about 143 KiB. Most of it is the keyboard's, which is only open in the config menu. Its pools
+// still live here, the only other place for them would be the titles heap again. The layer keeps the
+// border and background rows of the key grid once and only the rows labels reach apart, 114 of 179.
+
+#define ARENA_THREAD_STACK_SIZE 0x2000
+#define ARENA_GLYPH_ATLAS_SIZE 0x8000
+#define ARENA_KEYBOARD_LAYER_SIZE 0x17300
+#define ARENA_TZIF_SIZE 0x2000
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum ArenaPool {
+    ARENA_POOL_THREAD,
+    ARENA_POOL_CONFIG_ITEM_TIME,
+    ARENA_POOL_CONFIG_ITEM_NTP_SERVER,
+    ARENA_POOL_CONFIG_ITEM_TIMEZONE,
+    ARENA_POOL_GLYPH_ATLAS,
+    ARENA_POOL_KEYBOARD_LAYER,
+    ARENA_POOL_TZIF,
+    ARENA_POOL_COUNT,
+} ArenaPool;
+
+// Debug counters of a pool, updated with the coreinit atomics so signed where OSAddAtomic() wants it
+typedef struct ArenaStats {
+    volatile int32_t used;       // Blocks in use right now
+    volatile uint32_t highWater; // Maximum blocks ever used at the same time
+    volatile int32_t allocs;     // Successful allocations
+    volatile int32_t failures;   // Allocations failed because the pool was exhausted
+} ArenaStats;
+
+void arenaInit(void);
+void *arenaAlloc(ArenaPool pool);
+void arenaFree(ArenaPool pool, void *ptr);
+uint32_t arenaBlockSize(ArenaPool pool);
+const ArenaStats *arenaGetStats(ArenaPool pool);
+void arenaReport(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+
+// Pixel kernels of the keyboard renderer. They only work on memory, so tools/tests checks them on the host.
+
+// Divides each 16 bit lane of x by 255, rounded to nearest. Exact for x <= 255 * 255.
+#define DIV255_LANES(x) ((((x) + 0x00800080 + ((((x) + 0x00800080) >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF)
+
+// Blends color over n pixels, weighted by the coverage bytes. The channels are spread to 16 bit lanes, so
+// each 32 bit multiply blends two of them: red and blue in one word, green and alpha in the other.
+static inline void blendSpan(uint32_t *dst, const uint8_t *coverage, uint32_t n, uint32_t color)
+{
+    uint32_t srcRB = (color >> 8) & 0x00FF00FF;
+    uint32_t srcGA = color & 0x00FF00FF;
+
+    for(uint32_t i = 0; i < n; ++i)
+    {
+        uint32_t a = coverage[i];
+        if(a == 0)
+            continue;
+
+        if(a == 0xFF)
+        {
+            dst[i] = color;
+            continue;
+        }
+
+        uint32_t d = dst[i];
+        uint32_t rb = (srcRB * a) + (((d >> 8) & 0x00FF00FF) * (0xFF - a));
+        uint32_t ga = (srcGA * a) + ((d & 0x00FF00FF) * (0xFF - a));
+        dst[i] = (DIV255_LANES(rb) << 8) | DIV255_LANES(ga);
+    }
+}
@@ -1,16 +1,18 @@
 #include "ConfigItemNtpServer.h"
+#include "arena.h"
+#include "blend.h"
 #include "kbd.h"
 #include "schrift.h"
 #include <stdbool.h>
 #include <stdint.h>
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <memory.h>
-#include <coreinit/memdefaultheap.h>
 #include <coreinit/memory.h>
 #include <coreinit/screen.h>
-#include <coreinit/thread.h>
 #include <coreinit/time.h>
+#include <gx2/event.h>
 #include <padscore/kpad.h>
 #include <vpad/input.h>
 #include <wups.h>
@@ -21,9 +23,54 @@ static uint8_t *drcBuffer;
 static uint32_t tvSize;
 static uint32_t drcSize;
 
+// Everything is drawn to the DRC buffer, the TV gets a scaled copy of it (1.5x at 720p, 2.25x at 1080p).
+// The tables map each TV column/row to the DRC column/row it shows.
+static uint32_t tvWidth;
+static uint32_t tvHeight;
+static uint32_t tvScaleNum;
+static uint32_t tvScaleDen;
+static uint16_t tvSourceX[1920];
+static uint16_t tvSourceY[1080];
+
 static bool isBackBuffer;
 static SFT pFont;
 
+// Glyphs get rendered once per keyboard session into the atlas, text drawing only blits from there
+#define GLYPH_CACHE_SLOTS 128 // Power of two, about twice the glyphs the keyboard shows
+
+typedef enum
+{
+    GLYPH_FREE,
+    GLYPH_MISSING, // Not in the font
+    GLYPH_VALID,
+} GlyphState;
+
+typedef struct
+{
+    uint32_t codepoint;
+    uint16_t size;
+    uint8_t state;
+    uint16_t width;  // Of the bitmap, 0 if there is none
+    uint16_t height;
+    int16_t left;    // Offset of the bitmap from the pen
+    int16_t top;
+    int16_t advance;
+    uint32_t offset; // Of the bitmap in the atlas
+} CachedGlyph;
+
+static CachedGlyph glyphCache[GLYPH_CACHE_SLOTS];
+static uint8_t *atlas;
+static uint32_t atlasUsed;
+
+#define TEXT_LAYOUT_MAX (MAX_NTP_SERVER_LENTGH + 1)
+
+typedef struct
+{
+    const CachedGlyph *glyphs[TEXT_LAYOUT_MAX]; // NULL for characters the font doesn't have
+    uint16_t pen[TEXT_LAYOUT_MAX + 1];          // Pen position of each character, the last one is the width
+    uint32_t count;
+} TextLayout;
+
 typedef struct
 {
     uint8_t r;
@@ -43,13 +90,65 @@ typedef struct
 #define COLOR_BLUE       ((Color){ .r =  52, .g = 120, .b = 228, .a = 255 })
 #define FONT_SIZE 24
 
-static const char keymap[(10 * 4) - 3] = {
+// Key repeat of held buttons
+#define KEY_REPEAT_DELAY 500
+#define KEY_REPEAT_INTERVAL 150
+#define KEY_REPEAT_BUTTONS (VPAD_BUTTON_RIGHT | VPAD_BUTTON_LEFT | VPAD_BUTTON_DOWN | VPAD_BUTTON_UP | VPAD_BUTTON_A | VPAD_BUTTON_B)
+
+#define KEY_COUNT (10 * 4)
+
+static const char keymap[KEY_COUNT - 3] = {
     '1', '2', '3', '4', '5', '6', '7', '8', '9', '0',
     'Q', 'W', 'E', 'R', 'T', 'Y', 'U', 'I', 'O', 'P',
     'A', 'S', 'D', 'F', 'G', 'H', 'J', 'K', 'L', '.',
     'Z', 'X', 'C', 'V', 'B', 'N', 'M',
 };
 
+// Labels of the last three keys: <, > and ENTER
+static const uint32_t keySymbols[3] = { 0xE091, 0xE090, 0xE056 };
+
+// Laid out when the keyboard opens
+static const CachedGlyph *keyGlyphs[KEY_COUNT];
+static uint32_t keyLabelX[KEY_COUNT];
+static uint32_t fieldWidth; // Room for the longest text
+static uint32_t spaceWidth;
+// Laid out whenever the text or the cursor changes
+static TextLayout field;
+static uint32_t fieldVersion;
+
+// What a screen buffer shows, key is -1 if it wasn't drawn to yet
+typedef struct
+{
+    int32_t key;
+    uint32_t fieldVersion;
+} BufferState;
+
+static BufferState bufferState[2];
+
+// The key grid with its borders and labels never changes, so it gets rendered once into an 8 bit layer
+// when the keyboard opens. Index 255 is the border color, 0 - 254 the label coverage over the background
+// scaled to 254 steps, so full coverage is exactly black. Most rows of the grid are either a horizontal
+// border or background between the vertical borders, so the layer only stores those two rows once plus
+// the rows labels reach into, and layerRows maps each row of the grid to the one it shows.
+#define LAYER_LEFT 8
+#define LAYER_TOP (SCREEN_HEIGHT - 8 - 5 - (44 * 4))
+#define LAYER_WIDTH (((STEP + 3) * 10) + 3)
+#define LAYER_HEIGHT ((44 * 4) + 3)
+#define LAYER_LABEL_ROWS (FONT_SIZE + 4) // Per row of keys, room for the tallest label
+#define LAYER_ROWS (2 + (4 * LAYER_LABEL_ROWS))
+#define LAYER_ROW_BORDER 0
+#define LAYER_ROW_PLAIN 1
+#define LAYER_BORDER 0xFF
+#define LAYER_OPAQUE 0xFE
+
+_Static_assert(LAYER_WIDTH * LAYER_ROWS <= ARENA_KEYBOARD_LAYER_SIZE, "Keyboard layer doesn't fit its arena block");
+_Static_assert(LAYER_ROWS <= 0xFF, "Keyboard layer rows don't fit layerRows");
+
+static uint8_t *layer;
+static uint8_t layerRows[LAYER_HEIGHT];
+static uint32_t layerUsedRows;
+static uint32_t layerPalette[256];
+
 DECL_FUNCTION(void, OSScreenSetBufferEx, OSScreenID screen, void *addr)
 {
     switch(screen)
@@ -73,154 +172,259 @@ static inline uint32_t colorToOSScreen(Color color)
     return (((uint32_t)color.r) << 24) | (((uint32_t)color.g) << 16) | (((uint32_t)color.b) << 8) | ((uint32_t)color.a);
 }
 
-static void drawPixel(uint32_t x, uint32_t y, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-    if(a == 0)
-        return;
-
-    uint32_t i = (x + y * DRC_WIDTH) * 4;
-    if(i + 2 >= drcSize)
-        return;
-
-    // put pixel in the drc buffer
-    if(isBackBuffer)
-        i += drcSize;
-
-    uint32_t pixel;
-    float f;
-
-    if(a == 0xFF)
+static void detectTvMode()
+{
+    if(tvSize == 0x007E9000)
     {
-        pixel = r;
-        pixel <<=  8;
-        pixel |= g;
-        pixel <<= 8;
-        pixel |= b;
-        pixel <<= 8;
-
+        tvWidth = 1920;
+        tvHeight = 1080;
+        tvScaleNum = 9;
+        tvScaleDen = 4;
     }
     else
     {
-        f = a / 255.0f;
-
-        pixel = (r * f) + (drcBuffer[i] * (1.0f - f));
-        pixel <<= 8;
-        pixel |= (uint32_t)((g * f) + (drcBuffer[++i] * (1.0f - f)));
-        pixel <<= 8;
-        pixel |= (uint32_t)((b * f) + (drcBuffer[++i] * (1.0f - f)));
-        pixel <<= 8;
-
-        i -= 2;
+        tvWidth = TV_WIDTH;
+        tvHeight = 720;
+        tvScaleNum = 3;
+        tvScaleDen = 2;
     }
 
-    *((uint32_t *)(drcBuffer + i)) = pixel;
-
-    uint32_t USED_TV_WIDTH;
-    if(tvSize == 0x007E9000)
+    for(uint32_t x = 0; x < tvWidth; ++x)
     {
-        USED_TV_WIDTH = 1920;
-        f             = 2.25f;
+        uint32_t src = (x * tvScaleDen) / tvScaleNum;
+        tvSourceX[x] = src < SCREEN_WIDTH ? src : SCREEN_WIDTH - 1;
     }
-    else
+
+    for(uint32_t y = 0; y < tvHeight; ++y)
     {
-        USED_TV_WIDTH = TV_WIDTH;
-        f             = 1.5f;
+        uint32_t src = (y * tvScaleDen) / tvScaleNum;
+        tvSourceY[y] = src < SCREEN_HEIGHT ? src : SCREEN_HEIGHT - 1;
     }
+}
 
-    for(uint32_t yy = (y * f); yy < ((y * f) + f); yy++)
-        for(uint32_t xx = (x * f); xx < ((x * f) + f); xx++)
-        {
-            i = (xx + yy * USED_TV_WIDTH) * 4;
-            if(isBackBuffer)
-                i += tvSize;
+static inline uint32_t *drcRow(uint32_t y)
+{
+    return (uint32_t *)(drcBuffer + (isBackBuffer ? drcSize : 0)) + (y * DRC_WIDTH);
+}
 
-            *((uint32_t *)(tvBuffer + i)) = pixel;
-        }
+static inline uint32_t *tvRow(uint32_t y)
+{
+    return (uint32_t *)(tvBuffer + (isBackBuffer ? tvSize : 0)) + (y * tvWidth);
 }
 
+static inline void fillSpan(uint32_t *dst, uint32_t n, uint32_t pixel)
+{
+    for(; n >= 4; n -= 4, dst += 4)
+    {
+        dst[0] = pixel;
+        dst[1] = pixel;
+        dst[2] = pixel;
+        dst[3] = pixel;
+    }
+
+    while(n--)
+        *dst++ = pixel;
+}
+
+// Clips once, then fills row by row, ignoring the alpha of col
 static void drawRectFilled(uint32_t x, uint32_t y, uint32_t w, uint32_t h, Color col)
 {
-    for(uint32_t xx = x; xx < x + w; ++xx)
-        for(uint32_t yy = y; yy < y + h; ++yy)
-            drawPixel(xx, yy, col.r, col.g, col.b, col.a);
+    if(x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT)
+        return;
+    if(w > SCREEN_WIDTH - x)
+        w = SCREEN_WIDTH - x;
+    if(h > SCREEN_HEIGHT - y)
+        h = SCREEN_HEIGHT - y;
+    if(w == 0 || h == 0)
+        return;
+
+    uint32_t pixel = colorToOSScreen(col);
+    for(uint32_t yy = y; yy < y + h; ++yy)
+        fillSpan(drcRow(yy) + x, w, pixel);
 }
 
+// Clips the glyph once, then blends it in black row by row
 static void draw_freetype_bitmap(SFT_Image *bmp, int32_t x, int32_t y) {
-    int32_t i, j, p, q;
-
-    int32_t x_max = x + bmp->width;
-    int32_t y_max = y + bmp->height;
+    int32_t left = x < 0 ? -x : 0;
+    int32_t top = y < 0 ? -y : 0;
+    int32_t right = x + bmp->width > SCREEN_WIDTH ? SCREEN_WIDTH - x : bmp->width;
+    int32_t bottom = y + bmp->height > SCREEN_HEIGHT ? SCREEN_HEIGHT - y : bmp->height;
+    if(left >= right || top >= bottom)
+        return;
 
-    uint8_t *src = (uint8_t *) bmp->pixels;
-    float opacity;
+    const uint8_t *src = (const uint8_t *) bmp->pixels;
+    for(int32_t q = top; q < bottom; ++q)
+        blendSpan(drcRow(y + q) + x + left, src + (q * bmp->width) + left, right - left, colorToOSScreen(COLOR_BLACK));
+}
 
-    for (i = x, p = 0; i < x_max; i++, p++) {
-        for (j = y, q = 0; j < y_max; j++, q++) {
-            if (i < 0 || j < 0 || i >= SCREEN_WIDTH || j >= SCREEN_HEIGHT) {
-                continue;
-            }
+// Scales an area of the DRC buffer to the TV buffer. Every TV pixel of the area is written once and TV
+// rows showing the same DRC row as the one above are copied from it.
+static void scaleToTv(uint32_t x, uint32_t y, uint32_t w, uint32_t h)
+{
+    uint32_t tx = (x * tvScaleNum) / tvScaleDen;
+    uint32_t tw = (((x + w) * tvScaleNum) + tvScaleDen - 1) / tvScaleDen;
+    uint32_t ty = (y * tvScaleNum) / tvScaleDen;
+    uint32_t th = (((y + h) * tvScaleNum) + tvScaleDen - 1) / tvScaleDen;
+    if(tw > tvWidth)
+        tw = tvWidth;
+    if(th > tvHeight)
+        th = tvHeight;
+    if(tx >= tw || ty >= th)
+        return;
 
-            opacity = src[q * bmp->width + p] / 255.0f;
-            drawPixel(i, j, 0x00, 0x00, 0x00, 0xFF * opacity);
+    for(uint32_t yy = ty; yy < th; ++yy)
+    {
+        uint32_t *dst = tvRow(yy);
+        if(yy != ty && tvSourceY[yy] == tvSourceY[yy - 1])
+        {
+            OSBlockMove(dst + tx, tvRow(yy - 1) + tx, (tw - tx) * 4, false);
+            continue;
         }
+
+        const uint32_t *src = drcRow(tvSourceY[yy]);
+        for(uint32_t xx = tx; xx < tw; ++xx)
+            dst[xx] = src[tvSourceX[xx]];
     }
 }
 
-static void print(uint32_t x, uint32_t y, const wchar_t *string) {
-    uint32_t penX = (int32_t) x;
-    uint32_t penY = (int32_t) y;
+// Renders a glyph into the atlas the first time it's needed and returns it from there afterwards.
+// Returns NULL if the font has no such glyph.
+static const CachedGlyph *getGlyph(uint32_t codepoint)
+{
+    uint32_t size = pFont.yScale;
+    uint32_t slot = ((codepoint * 2654435761u) ^ size) & (GLYPH_CACHE_SLOTS - 1);
+    CachedGlyph *glyph;
+    for(uint32_t i = 0; i < GLYPH_CACHE_SLOTS; ++i, slot = (slot + 1) & (GLYPH_CACHE_SLOTS - 1))
+    {
+        glyph = glyphCache + slot;
+        if(glyph->state == GLYPH_FREE)
+            break;
+        if(glyph->codepoint == codepoint && glyph->size == size)
+            return glyph->state == GLYPH_VALID ? glyph : NULL;
+    }
 
-    uint16_t textureWidth = 0, textureHeight = 0;
-    for (; *string; string++) {
-        SFT_Glyph gid; //  unsigned long gid;
-        if (sft_lookup(&pFont, *string, &gid) >= 0) {
-            SFT_GMetrics mtx;
-            if (sft_gmetrics(&pFont, gid, &mtx) < 0)
-                return;
+    if(glyph->state != GLYPH_FREE)
+        return NULL; // The cache is full, which the keyboard never gets to
 
-            textureWidth  = (mtx.minWidth + 3) & ~3;
-            textureHeight = mtx.minHeight;
+    glyph->codepoint = codepoint;
+    glyph->size = size;
+    glyph->state = GLYPH_MISSING;
 
-            SFT_Image img = {
-                    .pixels = NULL,
-                    .width  = textureWidth,
-                    .height = textureHeight,
-            };
+    SFT_Glyph gid;
+    SFT_GMetrics mtx;
+    if(sft_lookup(&pFont, codepoint, &gid) < 0 || sft_gmetrics(&pFont, gid, &mtx) < 0)
+        return NULL;
 
-            if (textureWidth == 0)
-                textureWidth = 4;
+    glyph->state = GLYPH_VALID;
+    glyph->left = (int16_t) floor(mtx.leftSideBearing);
+    glyph->top = (int16_t) mtx.yOffset;
+    glyph->advance = (int16_t) mtx.advanceWidth;
 
-            if (textureHeight == 0)
-                textureHeight = 4;
+    SFT_Image img = {
+            .pixels = atlas + atlasUsed,
+            .width  = (mtx.minWidth + 3) & ~3,
+            .height = mtx.minHeight,
+    };
 
-            uint8_t *buffer = MEMAllocFromDefaultHeap(img.width * img.height);
-            if(!buffer)
-                return;
+    if (img.width == 0)
+        img.width = 4;
 
-            img.pixels = buffer;
-            if (sft_render(&pFont, gid, img) < 0)
-                return;
+    if (img.height == 0)
+        img.height = 4;
 
-            draw_freetype_bitmap(&img, (int32_t) (penX + mtx.leftSideBearing), (int32_t) (penY + mtx.yOffset));
-            penX += (int32_t) mtx.advanceWidth;
-        }
+    // A glyph not fitting in the atlas anymore still advances the pen, it just isn't drawn
+    glyph->width = glyph->height = 0;
+    if (atlas != NULL && (uint32_t) (img.width * img.height) <= ARENA_GLYPH_ATLAS_SIZE - atlasUsed && sft_render(&pFont, gid, img) >= 0)
+    {
+        glyph->width = img.width;
+        glyph->height = img.height;
+        glyph->offset = atlasUsed;
+        atlasUsed += img.width * img.height;
     }
+
+    return glyph;
 }
 
-static uint32_t getTextWidth(const wchar_t *string) {
-    uint32_t width = 0;
+static void drawGlyph(const CachedGlyph *glyph, int32_t penX, int32_t penY)
+{
+    if (glyph == NULL || glyph->width == 0)
+        return;
+
+    SFT_Image img = {
+            .pixels = atlas + glyph->offset,
+            .width  = glyph->width,
+            .height = glyph->height,
+    };
 
-    for (; *string; string++) {
-        SFT_Glyph gid; //  unsigned long gid;
-        if (sft_lookup(&pFont, *string, &gid) >= 0) {
-            SFT_GMetrics mtx;
-            if(sft_gmetrics(&pFont, gid, &mtx) >= 0)
-                width += (int32_t) mtx.advanceWidth;
-        }
+    draw_freetype_bitmap(&img, penX + glyph->left, penY + glyph->top);
+}
+
+// Looks up the glyphs of a string once and keeps their pen positions, so drawing and measuring it again is free
+static void layoutText(TextLayout *layout, const wchar_t *string)
+{
+    uint32_t pen = 0;
+    uint32_t i;
+    for (i = 0; i < TEXT_LAYOUT_MAX && string[i]; ++i)
+    {
+        layout->pen[i] = pen;
+        layout->glyphs[i] = getGlyph(string[i]);
+        if (layout->glyphs[i] != NULL)
+            pen += layout->glyphs[i]->advance;
     }
 
-    return width;
+    layout->pen[i] = pen;
+    layout->count = i;
 }
 
+static inline uint32_t textWidth(const TextLayout *layout)
+{
+    return layout->pen[layout->count];
+}
+
+static void drawText(const TextLayout *layout, int32_t x, int32_t y)
+{
+    for (uint32_t i = 0; i < layout->count; ++i)
+        drawGlyph(layout->glyphs[i], x + layout->pen[i], y);
+}
+
+// The text field shows the text with a space at the cursor, which the cursor gets drawn into
+static void layoutField(const wchar_t *str, uint32_t cursor)
+{
+    wchar_t buf[MAX_NTP_SERVER_LENTGH + 1];
+    uint32_t i;
+    for (i = 0; i < cursor; ++i)
+        buf[i] = str[i];
+
+    buf[i] = ' ';
+    for (; str[i] != 0; ++i)
+        buf[i + 1] = str[i];
+
+    buf[i + 1] = 0;
+    layoutText(&field, buf);
+    ++fieldVersion;
+}
+
+// Everything that stays the same while the keyboard is open
+static void layoutKeyboard()
+{
+    wchar_t buf[MAX_NTP_SERVER_LENTGH + 1];
+    for (uint32_t i = 0; i < MAX_NTP_SERVER_LENTGH - 1; ++i)
+        buf[i] = 'm';
+
+    buf[MAX_NTP_SERVER_LENTGH - 1] = ' ';
+    buf[MAX_NTP_SERVER_LENTGH] = 0;
+    layoutText(&field, buf);
+    fieldWidth = textWidth(&field);
+
+    const CachedGlyph *space = getGlyph(' ');
+    spaceWidth = space == NULL ? 0 : space->advance;
+
+    for (uint32_t z = 0; z < KEY_COUNT; ++z)
+    {
+        keyGlyphs[z] = getGlyph(z < sizeof(keymap) ? (uint32_t) keymap[z] : keySymbols[z - sizeof(keymap)]);
+        keyLabelX[z] = 8 + 3 + ((z % 10) * (STEP + 3)) + (STEP / 2) - ((keyGlyphs[z] == NULL ? 0 : keyGlyphs[z]->advance) / 2);
+    }
+}
 
 static uint32_t mapClassicButtons(uint32_t buttonMap)
 {
@@ -271,51 +475,122 @@ static uint32_t mapWiiButtons(uint32_t buttonMap)
     return ret;
 }
 
-static void drawKeyboard(uint32_t x, uint32_t y, const wchar_t *str, uint32_t cursor)
+// Gives a row of the grid a layer row of its own, so a label can be drawn into it
+static uint8_t *layerRow(int32_t y)
 {
-    OSScreenClearBufferEx(SCREEN_DRC, colorToOSScreen(COLOR_BACKGROUND));
-    OSScreenClearBufferEx(SCREEN_TV, colorToOSScreen(COLOR_BACKGROUND));
+    if(layerRows[y] > LAYER_ROW_PLAIN)
+        return layer + (layerRows[y] * LAYER_WIDTH);
+    if(layerUsedRows == LAYER_ROWS)
+        return NULL;
+
+    uint8_t *row = layer + (layerUsedRows * LAYER_WIDTH);
+    OSBlockMove(row, layer + (layerRows[y] * LAYER_WIDTH), LAYER_WIDTH, false);
+    layerRows[y] = layerUsedRows++;
+    return row;
+}
 
-    drawRectFilled(8 + 3 + (x * (STEP + 3)), SCREEN_HEIGHT - 8 - 5 - (44 * 4) + 3 + (y * 44), STEP, 44 - 3, COLOR_BLUE);
+static bool layerGlyph(const CachedGlyph *glyph, int32_t penX, int32_t penY)
+{
+    if (glyph == NULL || glyph->width == 0)
+        return true;
 
-    wchar_t buf[MAX_NTP_SERVER_LENTGH + 1];
-    for(y = 0; y < MAX_NTP_SERVER_LENTGH - 1; ++y)
-        buf[y] = 'm';
+    int32_t x = penX + glyph->left - LAYER_LEFT;
+    int32_t y = penY + glyph->top - LAYER_TOP;
+    const uint8_t *src = atlas + glyph->offset;
+    for(int32_t q = 0; q < glyph->height; ++q)
+    {
+        if(y + q < 0 || y + q >= LAYER_HEIGHT)
+            continue;
 
-    buf[MAX_NTP_SERVER_LENTGH - 1] = ' ';
-    buf[MAX_NTP_SERVER_LENTGH] = 0;
-    y = getTextWidth(buf);
+        uint8_t *row = layerRow(y + q);
+        if(row == NULL)
+            return false;
 
-    for(x = 0; x < cursor; ++x)
-        buf[x] = str[x];
+        for(int32_t p = 0; p < glyph->width; ++p)
+        {
+            uint32_t a = src[(q * glyph->width) + p];
+            if(a != 0 && x + p >= 0 && x + p < LAYER_WIDTH)
+                row[x + p] = ((a * LAYER_OPAQUE) + 127) / 255;
+        }
+    }
 
-    buf[x] = ' ';
+    return true;
+}
 
-    if(str[x] != 0)
+// Returns false if the labels need more rows than the layer has
+static bool renderLayer()
+{
+    uint32_t background = colorToOSScreen(COLOR_BACKGROUND);
+    uint32_t black = colorToOSScreen(COLOR_BLACK);
+    for(uint32_t i = 0; i <= LAYER_OPAQUE; ++i)
     {
-        for(; str[x] != 0; ++x)
-            buf[x + 1] = str[x];
+        uint8_t a = ((i * 255) + (LAYER_OPAQUE / 2)) / LAYER_OPAQUE;
+        layerPalette[i] = background;
+        blendSpan(layerPalette + i, &a, 1, black);
     }
 
-    buf[++x] = 0;
+    layerPalette[LAYER_BORDER] = colorToOSScreen(COLOR_BORDER);
 
-    x = (SCREEN_WIDTH / 2) - 8 - 3 - (y / 2),
-    drawRectFilled(x, (SCREEN_HEIGHT / 2) - ((44 * 5) / 2) - (44 / 2), y + 16, 3, COLOR_BLUE);
-    drawRectFilled(x, (SCREEN_HEIGHT / 2) - ((44 * 5) / 2) + (44 / 2), y + 16, 3, COLOR_BLUE);
-    drawRectFilled(x, (SCREEN_HEIGHT / 2) - ((44 * 5) / 2) - (44 / 2), 3, 44 + 3, COLOR_BLUE);
-    drawRectFilled(x + y + 16, (SCREEN_HEIGHT / 2) - ((44 * 5) / 2) - (44 / 2), 3, 44 + 3, COLOR_BLUE);
-    x += 8;
-    print(x, (SCREEN_HEIGHT / 2) - ((44 * 5) / 2) + (FONT_SIZE / 2), buf);
+    OSBlockSet(layer + (LAYER_ROW_BORDER * LAYER_WIDTH), LAYER_BORDER, LAYER_WIDTH);
+    OSBlockSet(layer + (LAYER_ROW_PLAIN * LAYER_WIDTH), 0, LAYER_WIDTH);
+    for(uint32_t x = 0; x < LAYER_WIDTH; x += STEP + 3)
+        OSBlockSet(layer + (LAYER_ROW_PLAIN * LAYER_WIDTH) + x, LAYER_BORDER, 3);
+
+    for(uint32_t y = 0; y < LAYER_HEIGHT; ++y)
+        layerRows[y] = (y % 44) < 3 ? LAYER_ROW_BORDER : LAYER_ROW_PLAIN;
+
+    layerUsedRows = 2;
+    for(uint32_t z = 0; z < KEY_COUNT; ++z)
+        if(!layerGlyph(keyGlyphs[z], keyLabelX[z], SCREEN_HEIGHT - 8 - 5 - (44 * 3) - (FONT_SIZE / 2) + (44 * (z / 10))))
+            return false;
+
+    return true;
+}
+
+// Copies an area of the layer to the DRC buffer, expanding the palette
+static void copyLayer(uint32_t x, uint32_t y, uint32_t w, uint32_t h)
+{
+    for(uint32_t yy = y; yy < y + h; ++yy)
+    {
+        const uint8_t *src = layer + (layerRows[yy - LAYER_TOP] * LAYER_WIDTH) + x - LAYER_LEFT;
+        uint32_t *dst = drcRow(yy) + x;
+        for(uint32_t i = 0; i < w; ++i)
+            dst[i] = layerPalette[src[i]];
+    }
+}
+
+#define KEY_TOP (SCREEN_HEIGHT - 8 - 5 - (44 * 4) + 3)
+#define FIELD_TOP ((SCREEN_HEIGHT / 2) - ((44 * 5) / 2) - (44 / 2))
+#define FIELD_LEFT ((SCREEN_WIDTH / 2) - 8 - 3 - (fieldWidth / 2))
 
-    for(y = 0; y < cursor; ++y)
-        buf[y] = str[y];
+// A key without its borders, the highlight fills exactly that. A full redraw scales everything to the TV
+// at once afterwards, so toTv is false then.
+static void drawKey(uint32_t z, bool highlighted, bool toTv)
+{
+    uint32_t x = 8 + 3 + ((z % 10) * (STEP + 3));
+    uint32_t y = KEY_TOP + ((z / 10) * 44);
+    if(!highlighted && layer != NULL)
+        copyLayer(x, y, STEP, 44 - 3);
+    else
+    {
+        drawRectFilled(x, y, STEP, 44 - 3, highlighted ? COLOR_BLUE : COLOR_BACKGROUND);
+        drawGlyph(keyGlyphs[z], keyLabelX[z], SCREEN_HEIGHT - 8 - 5 - (44 * 3) - (FONT_SIZE / 2) + (44 * (z / 10)));
+    }
 
-    buf[cursor] = 0;
-    x += getTextWidth(buf);
+    if(toTv)
+        scaleToTv(x, y, STEP, 44 - 3);
+}
 
-    buf[0] = ' ';
-    buf[1] = 0;
-    x += getTextWidth(buf) / 2;
+// The inside of the text field box: text and cursor
+static void drawField(uint32_t cursor, bool toTv)
+{
+    uint32_t x = FIELD_LEFT;
+    drawRectFilled(x + 3, FIELD_TOP + 3, fieldWidth + 16 - 3, 44 - 3, COLOR_BACKGROUND);
+    x += 8;
+    drawText(&field, x, (SCREEN_HEIGHT / 2) - ((44 * 5) / 2) + (FONT_SIZE / 2));
+
+    x += field.pen[cursor];
+    x += spaceWidth / 2;
     x += 3;
 
     drawRectFilled(x, ((SCREEN_HEIGHT / 2) - ((44 * 5) / 2) + (FONT_SIZE / 2)) + 3, 3, 2, COLOR_BLUE);
@@ -328,39 +603,71 @@ static void drawKeyboard(uint32_t x, uint32_t y, const wchar_t *str, uint32_t cu
     drawRectFilled(x, ((SCREEN_HEIGHT / 2) - ((44 * 5) / 2) + (FONT_SIZE / 2)) + 3, 3, 2, COLOR_BLUE);
     drawRectFilled(x, ((SCREEN_HEIGHT / 2) - ((44 * 5) / 2) - (FONT_SIZE / 2)) + 1, 3, 2, COLOR_BLUE);
 
-    for(y = SCREEN_HEIGHT - 8 - 5; y > SCREEN_HEIGHT - (44 * 5); y -= 44)
-        drawRectFilled(8, y, (STEP * 10) + (3 * 10), 3, COLOR_BORDER);
-
-    for(x = 8; x < 8 + ((STEP + 3) * 11); x += STEP + 3)
-         drawRectFilled(x, SCREEN_HEIGHT - 8 - 5 - (44 * 4), 3, (44 * 4) + 3, COLOR_BORDER);
+    if(toTv)
+        scaleToTv(FIELD_LEFT + 3, FIELD_TOP + 3, fieldWidth + 16 - 3, 44 - 3);
+}
 
-    for(y = 0; y < 3; ++y)
-        buf[y] = 0;
+// Redraws what changed since the back buffer was last drawn to, which is two frames ago. Only the first
+// frame of each buffer gets drawn completely.
+static void drawKeyboard(uint32_t x, uint32_t y, uint32_t cursor)
+{
+    int32_t key = (y * 10) + x;
+    BufferState *state = bufferState + isBackBuffer;
 
-    for(y = 0; y < 4; ++y)
+    if(state->key < 0)
     {
-        for(x = 0; x < (y < 3 ? 10 : 7); ++x)
+        OSScreenClearBufferEx(SCREEN_DRC, colorToOSScreen(COLOR_BACKGROUND));
+
+        y = fieldWidth;
+        x = FIELD_LEFT;
+        drawRectFilled(x, FIELD_TOP, y + 16, 3, COLOR_BLUE);
+        drawRectFilled(x, FIELD_TOP + 44, y + 16, 3, COLOR_BLUE);
+        drawRectFilled(x, FIELD_TOP, 3, 44 + 3, COLOR_BLUE);
+        drawRectFilled(x + y + 16, FIELD_TOP, 3, 44 + 3, COLOR_BLUE);
+
+        if(layer != NULL)
+            copyLayer(LAYER_LEFT, LAYER_TOP, LAYER_WIDTH, LAYER_HEIGHT);
+        else
         {
-            buf[0] = keymap[(y * 10) + x];
-            print((8 + 3 + (x * (STEP + 3)) + (STEP / 2)) - (getTextWidth(buf) / 2), SCREEN_HEIGHT - 8 - 5 - (44 * 3) - (FONT_SIZE / 2) + (44 * y), buf);
+            for(y = SCREEN_HEIGHT - 8 - 5; y > SCREEN_HEIGHT - (44 * 5); y -= 44)
+                drawRectFilled(8, y, (STEP * 10) + (3 * 10), 3, COLOR_BORDER);
+
+            for(x = 8; x < 8 + ((STEP + 3) * 11); x += STEP + 3)
+                 drawRectFilled(x, SCREEN_HEIGHT - 8 - 5 - (44 * 4), 3, (44 * 4) + 3, COLOR_BORDER);
+
+            for(int32_t z = 0; z < KEY_COUNT; ++z)
+                drawGlyph(keyGlyphs[z], keyLabelX[z], SCREEN_HEIGHT - 8 - 5 - (44 * 3) - (FONT_SIZE / 2) + (44 * (z / 10)));
         }
+
+        drawKey(key, true, false);
+        drawField(cursor, false);
+        scaleToTv(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
     }
+    else
+    {
+        if(state->key != key)
+        {
+            drawKey(state->key, false, true);
+            drawKey(key, true, true);
+        }
 
-    mbstowcs(buf, "\uE091", strlen("\uE091")); // <
-    print((8 + 3 + (7 * (STEP + 3)) + (STEP / 2)) - (getTextWidth(buf) / 2), SCREEN_HEIGHT - 8 - 5 - (FONT_SIZE / 2), buf);
-    mbstowcs(buf, "\uE090", strlen("\uE090")); // >
-    print((8 + 3 + (8 * (STEP + 3)) + (STEP / 2)) - (getTextWidth(buf) / 2), SCREEN_HEIGHT - 8 - 5 - (FONT_SIZE / 2), buf);
+        if(state->fieldVersion != fieldVersion)
+            drawField(cursor, true);
+    }
 
-    mbstowcs(buf, "\uE056", strlen("\uE056")); // ENTER
-    print((8 + 3 + (9 * (STEP + 3)) + (STEP / 2)) - (getTextWidth(buf) / 2), SCREEN_HEIGHT - 8 - 5 - (FONT_SIZE / 2), buf);
+    state->key = key;
+    state->fieldVersion = fieldVersion;
 
     OSScreenFlipBuffersEx(SCREEN_DRC);
     OSScreenFlipBuffersEx(SCREEN_TV);
     isBackBuffer = !isBackBuffer;
 }
 
-void renderKeyboard(char *str)
+void renderKeyboard(char *str, uint32_t capacity, const char *defaultValue)
 {
+    if(capacity > MAX_NTP_SERVER_LENTGH)
+        capacity = MAX_NTP_SERVER_LENTGH;
+
     void *font = NULL;
     uint32_t size = 0;
     OSGetSharedData(OS_SHAREDDATATYPE_FONT_STANDARD, 0, &font, &size);
@@ -376,6 +683,20 @@ void renderKeyboard(char *str)
     pFont.yScale = FONT_SIZE;
     pFont.flags = SFT_DOWNWARD_Y;
 
+    OSBlockSet(glyphCache, 0, sizeof(glyphCache));
+    atlas = arenaAlloc(ARENA_POOL_GLYPH_ATLAS);
+    atlasUsed = 0;
+    layoutKeyboard();
+    bufferState[0].key = bufferState[1].key = -1;
+
+    // Without the layer the grid gets drawn directly
+    layer = arenaAlloc(ARENA_POOL_KEYBOARD_LAYER);
+    if(layer != NULL && !renderLayer())
+    {
+        arenaFree(ARENA_POOL_KEYBOARD_LAYER, layer);
+        layer = NULL;
+    }
+
     size = *(uint32_t *) tvBuffer;
 
     // check which buffer is currently used
@@ -384,6 +705,7 @@ void renderKeyboard(char *str)
 
     // restore the pixel we used for checking
     *(uint32_t *) tvBuffer = size;
+    detectTvMode();
 
     wchar_t wstr[MAX_NTP_SERVER_LENTGH];
     OSBlockSet(wstr, 0, sizeof(wchar_t) * MAX_NTP_SERVER_LENTGH);
@@ -401,24 +723,29 @@ void renderKeyboard(char *str)
     int32_t x = 0;
     int32_t y = 0;
     uint32_t cursor = size;
-    uint32_t cooldown = 26;
+    uint32_t lastHeld = 0;
+    uint32_t ignore = KEY_REPEAT_BUTTONS; // Buttons still held from opening the keyboard don't count till released
+    OSTime repeatAt = 0;
     bool trigger = false;
+    bool textChanged = true;
+    bool redraw = true;
 
     do
     {
+        uint32_t held = 0;
         VPADRead(VPAD_CHAN_0, &vpad, 1, &verror);
         if(verror == VPAD_READ_SUCCESS)
         {
-            vpad.trigger |= vpad.hold;
+            held = vpad.hold;
 
-            if(vpad.trigger & VPAD_STICK_L_EMULATION_RIGHT)
-                vpad.trigger |= VPAD_BUTTON_RIGHT;
-            if(vpad.trigger & VPAD_STICK_L_EMULATION_LEFT)
-                vpad.trigger |= VPAD_BUTTON_LEFT;
-            if(vpad.trigger & VPAD_STICK_L_EMULATION_DOWN)
-                vpad.trigger |= VPAD_BUTTON_DOWN;
-            if(vpad.trigger & VPAD_STICK_L_EMULATION_UP)
-                vpad.trigger |= VPAD_BUTTON_UP;
+            if(held & VPAD_STICK_L_EMULATION_RIGHT)
+                held |= VPAD_BUTTON_RIGHT;
+            if(held & VPAD_STICK_L_EMULATION_LEFT)
+                held |= VPAD_BUTTON_LEFT;
+            if(held & VPAD_STICK_L_EMULATION_DOWN)
+                held |= VPAD_BUTTON_DOWN;
+            if(held & VPAD_STICK_L_EMULATION_UP)
+                held |= VPAD_BUTTON_UP;
 
             if(vpad.tpNormal.touched)
             {
@@ -438,146 +765,167 @@ void renderKeyboard(char *str)
                             x = vpad.tpFiltered1.x;
                             y = vpad.tpFiltered1.y;
                             trigger = true;
-                            cooldown = 26;
                         }
                     }
                 }
             }
             else
                 vpadTouchHeld = false;
-
         }
-        else
-            vpad.trigger = 0;
 
         for(int i = 0; i < 4; i++)
             if(KPADReadEx((KPADChan)i, &kpad, 1, &kerror) > 0 && kerror == KPAD_ERROR_OK && kpad.extensionType != 0xFF)
-                vpad.trigger |= kpad.extensionType == WPAD_EXT_CORE || kpad.extensionType == WPAD_EXT_NUNCHUK ? mapWiiButtons(kpad.trigger & kpad.hold) : mapClassicButtons(kpad.classic.trigger & kpad.classic.hold);
+                held |= kpad.extensionType == WPAD_EXT_CORE || kpad.extensionType == WPAD_EXT_NUNCHUK ? mapWiiButtons(kpad.hold) : mapClassicButtons(kpad.classic.hold);
+
+        held &= KEY_REPEAT_BUTTONS;
+        ignore &= held;
+        held &= ~ignore;
+
+        // New presses act at once, held buttons repeat after a delay
+        OSTime now = OSGetSystemTime();
+        uint32_t buttons = held & ~lastHeld;
+        if(buttons)
+            repeatAt = now + OSMillisecondsToTicks(KEY_REPEAT_DELAY);
+        else if(held && now >= repeatAt)
+        {
+            buttons = held;
+            repeatAt = now + OSMillisecondsToTicks(KEY_REPEAT_INTERVAL);
+        }
+
+        lastHeld = held;
 
-        if(!cooldown)
+        if(buttons & VPAD_BUTTON_RIGHT)
         {
-            if(vpad.trigger & VPAD_BUTTON_RIGHT)
-            {
-                if(++x > 9)
-                    x = 0;
+            if(++x > 9)
+                x = 0;
 
-                cooldown = 25;
-            }
-            if(vpad.trigger & VPAD_BUTTON_LEFT)
-            {
-                if(--x < 0)
-                    x = 9;
+            redraw = true;
+        }
+        if(buttons & VPAD_BUTTON_LEFT)
+        {
+            if(--x < 0)
+                x = 9;
 
-                cooldown = 25;
-            }
-            if(vpad.trigger& VPAD_BUTTON_DOWN)
-            {
-                if(++y > 3)
-                    y = 0;
+            redraw = true;
+        }
+        if(buttons & VPAD_BUTTON_DOWN)
+        {
+            if(++y > 3)
+                y = 0;
 
-                cooldown = 25;
-            }
-            if(vpad.trigger & VPAD_BUTTON_UP)
-            {
-                if(--y < 0)
-                    y = 3;
+            redraw = true;
+        }
+        if(buttons & VPAD_BUTTON_UP)
+        {
+            if(--y < 0)
+                y = 3;
 
-                cooldown = 25;
-            }
-            if(vpad.trigger & VPAD_BUTTON_A)
-            {
-                trigger = true;
-                cooldown = 25;
-            }
-            if(vpad.trigger & VPAD_BUTTON_B)
+            redraw = true;
+        }
+        if(buttons & VPAD_BUTTON_A)
+            trigger = true;
+        if(buttons & VPAD_BUTTON_B)
+        {
+            if(!cursor)
+                break;
+
+            if(cursor == size)
+                wstr[--size] = 0;
+            else
             {
-                if(!cursor)
-                    break;
+                --size;
 
-                if(cursor == size)
-                    wstr[--size] = 0;
-                else
+                uint32_t i = cursor - 1;
+                do
                 {
-                    --size;
-
-                    uint32_t i = cursor - 1;
-                    do
-                    {
-                        wstr[i] = wstr[i + 1];
-                        if(wstr[i] == 0)
-                            break;
+                    wstr[i] = wstr[i + 1];
+                    if(wstr[i] == 0)
+                        break;
 
-                        ++i;
-                    }
-                    while(1);
+                    ++i;
                 }
-
-                --cursor;
-                cooldown = 25;
+                while(1);
             }
-        }
-        else
-        {
-            if(vpad.trigger || cooldown == 26)
-                --cooldown;
-            else
-                cooldown = 0;
+
+            --cursor;
+            textChanged = true;
         }
 
-        if(cooldown == 25)
+        if(trigger)
         {
             uint32_t z = (y * 10) + x;
-            if(trigger)
+            if(z < (4 * 10) - 3)
             {
-                if(z < (4 * 10) - 3)
+                if(size < capacity - 1)
                 {
-                    if(size < MAX_NTP_SERVER_LENTGH - 1)
-                    {
-                        if(cursor != size)
-                            for(uint32_t i = size - 1; i > cursor - 1; --i)
-                                wstr[i + 1] = wstr[i];
+                    if(cursor != size)
+                        for(uint32_t i = size - 1; i > cursor - 1; --i)
+                            wstr[i + 1] = wstr[i];
 
-                        wstr[cursor] = keymap[z];
-                        if(z != 29 && z > 9)
-                            wstr[cursor] += 32;
+                    wstr[cursor] = keymap[z];
+                    if(z != 29 && z > 9)
+                        wstr[cursor] += 32;
 
-                        ++size;
-                        ++cursor;
-                    }
+                    ++size;
+                    ++cursor;
+                    textChanged = true;
                 }
-                else if(z == (4 * 10) - 1)
+            }
+            else if(z == (4 * 10) - 1)
+            {
+                if(size)
                 {
-                    if(size)
-                    {
-                        for(uint32_t i = 0; i < size; ++i)
-                            str[i] = wstr[i];
+                    for(uint32_t i = 0; i < size; ++i)
+                        str[i] = wstr[i];
 
-                        str[size] = '\0';
-                    }
-                    else
-                        strcpy(str, "pool.ntp.org");
-
-                    break;
-                }
-                else if(z == (4 * 10) - 2)
-                {
-                    if(++cursor > size)
-                        --cursor;
-                }
-                else if(z == (4 * 10) - 3)
-                {
-                    if(--cursor == (uint32_t)-1)
-                        cursor = 0;
+                    str[size] = '\0';
                 }
+                else
+                    strcpy(str, defaultValue);
 
-                trigger = false;
+                break;
             }
+            else if(z == (4 * 10) - 2)
+            {
+                if(++cursor > size)
+                    --cursor;
 
-            drawKeyboard(x, y, wstr, cursor);
+                textChanged = true;
+            }
+            else if(z == (4 * 10) - 3)
+            {
+                if(--cursor == (uint32_t)-1)
+                    cursor = 0;
+
+                textChanged = true;
+            }
+
+            trigger = false;
+            redraw = true;
+        }
+
+        if(textChanged)
+        {
+            layoutField(wstr, cursor);
+            textChanged = false;
+            redraw = true;
+        }
+
+        if(redraw)
+        {
+            drawKeyboard(x, y, cursor);
+            redraw = false;
         }
 
-        OSSleepTicks(OSMillisecondsToTicks(20));
+        // Input gets polled once per frame, so it shows up with the next one
+        GX2WaitForVsync();
     } while(1);
 
+    if(layer != NULL)
+        arenaFree(ARENA_POOL_KEYBOARD_LAYER, layer);
+
+    if(atlas != NULL)
+        arenaFree(ARENA_POOL_GLYPH_ATLAS, atlas);
+
     sft_freefont(pFont.font);
 }
@@ -1,10 +1,12 @@
 #pragma once
+#include <wut.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void renderKeyboard(char *str);
+// capacity is the size of str including the \0, the keyboard takes at most MAX_NTP_SERVER_LENTGH
+void renderKeyboard(char *str, uint32_t capacity, const char *defaultValue);
 
 #ifdef __cplusplus
 }
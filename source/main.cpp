@@ -1,17 +1,25 @@
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <sys/socket.h>
+#include <sys/select.h>
+#include <fcntl.h>
+#include <strings.h>
 
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
+#include <ctime>
 
+#include <coreinit/alarm.h>
 #include <coreinit/atomic.h>
-#include <coreinit/memdefaultheap.h>
+#include <coreinit/atomic64.h>
+#include <coreinit/debug.h>
 #include <coreinit/memory.h>
 #include <coreinit/messagequeue.h>
+#include <coreinit/mutex.h>
 #include <coreinit/thread.h>
 #include <coreinit/time.h>
+#include <gx2/swap.h>
 #include <nn/pdm.h>
 #include <notifications/notifications.h>
 #include <padscore/kpad.h>
@@ -19,28 +27,71 @@
 #include <wups.h>
 #include <wups/config.h>
 #include <wups/config/WUPSConfigItemBoolean.h>
-#include <wups/config/WUPSConfigItemMultipleValues.h>
 #include <wups/function_patching.h>
 
 #include "ConfigItemNtpServer.h"
 #include "ConfigItemTime.h"
-#include "timezones.h"
-
-#define NTPSERVER_CONFIG_ID "ntpServer"
-#define SYNCING_ENABLED_CONFIG_ID "enabledSync"
-#define TIMEZONE_CONFIG_ID "timezone"
-// Seconds between 1900 (NTP epoch) and 2000 (Wii U epoch)
-#define NTP_TIMESTAMP_DELTA 3155673600llu
-#define DEFAULT_TIMEZONE 321
-
-#define LI_UNSYNC 0xc0
-#define MODE_MASK 0x07
-#define MODE_CLIENT 0x03
-#define MODE_SERVER 0x04
-
-#define TIME_QUEUE_SIZE 2
-#define NOTIF_QUEUE_SIZE 10
+#include "ConfigItemTimezone.h"
+#include "arena.h"
+#include "ntpclient.h"
+#include "settings.h"
+#include "tzdb.h"
+#include "tzif.h"
+
+// Seconds between 1970 (Unix epoch) and 2000 (Wii U epoch)
+#define UNIX_TIMESTAMP_DELTA 946684800ll
+
+// Timeouts in milliseconds
+#define HTTP_TIMEOUT 5000
+// Time to wait for NTP before racing the HTTP fallback against it
+#define HTTP_FALLBACK_DELAY 500
+
+// Minimum seconds between two syncs to measure the clock drift and the maximum drift accepted (parts per billion)
+#define DRIFT_MIN_INTERVAL 600
+#define DRIFT_MAX 500000
+
+#define WORKER_QUEUE_SIZE 16
 #define MSG_EXIT ((void *)0xDEADBABE)
+#define MSG_DST ((void *)0xDEADBEEF)
+#define MSG_SYNC ((void *)0x00000000)
+#define MSG_SYNC_NOW ((void *)0x00000001)
+#define MSG_TIMER ((void *)0x00000002)
+#define MSG_PREVIEW ((void *)0x00000003)
+#define MSG_PREVIEW_START ((void *)0x00000004)
+#define MSG_PREVIEW_STOP ((void *)0x00000005)
+
+#define PENDING_SYNC 0x01
+#define PENDING_DST 0x02
+
+#define HOOK_TRACK_ACTIVITY 0x01 // A deferred sync waits for the title to become idle
+#define HOOK_CONFIG 0x02         // The config menu is open
+
+// Times in milliseconds without input / new frames after which the title is considered idle
+#define INPUT_IDLE_TIME 5000
+#define FRAME_IDLE_TIME 250
+// Maximum time a sync or clock step waits for the title to become idle
+#define MAX_DEFERRAL 60000
+#define DEFERRAL_POLL_INTERVAL 50
+// Maximum time in milliseconds messages wait while the worker waits for sockets
+#define SOCKET_POLL_INTERVAL 20
+// Notifications wait in a ring buffer of this size (in bytes) till the overlay is ready
+#define NOTIF_RING_SIZE 1024
+#define NOTIF_MAX_LENGTH 128
+// Retry interval in milliseconds while the notification overlay isn't ready, doubled on every retry
+#define NOTIF_RETRY_INTERVAL 100
+#define NOTIF_RETRY_INTERVAL_MAX 1600
+// Seconds between the NTP queries of the config menus preview
+#define PREVIEW_SYNC_INTERVAL 30
+
+// Maximum time in microseconds for a single step on the boot path
+#define INIT_BUDGET 500
+
+// Optional TZif files, named like the zones (e.g. Europe/Berlin), override the compiled rules
+#define TZIF_PATH "fs:/vol/external01/wiiu/zoneinfo/"
+
+// OSGetSystemTime() in units of 65536 ticks (about 1 ms) so it can be read and written atomically
+#define ACTIVITY_TIME() static_cast<uint32_t>(OSGetSystemTime() >> 16)
+#define ACTIVITY_MS(ms) static_cast<uint32_t>(OSMillisecondsToTicks(ms) >> 16)
 
 // Important plugin information.
 WUPS_PLUGIN_NAME("SNTP Client");
@@ -52,449 +103,982 @@ WUPS_PLUGIN_LICENSE("MIT");
 WUPS_USE_WUT_DEVOPTAB();
 WUPS_USE_STORAGE("SNTP Client");
 
-static volatile bool enabledSync = true;
-static volatile char ntp_server[MAX_NTP_SERVER_LENTGH] = "pool.ntp.org";
-static int32_t timezone = DEFAULT_TIMEZONE;
+// Header of a notification in the ring, directly followed by its text
+typedef struct
+{
+    uint16_t length;  // Room for the text, including the terminating NUL. 0 marks the rest of the ring as unused.
+    uint8_t error;
+    uint8_t repeat;   // How often the same notification was queued
+    const char *kind; // Format string of a sync error or NULL, see syncError()
+} NOTIFICATION;
+
+// Size of a notification in the ring, kept aligned to the header
+#define NOTIF_SIZE(length) ((sizeof(NOTIFICATION) + (length) + 3) & ~3)
+
 static volatile int32_t timezoneOffset;
+static const TzRule *volatile timezoneRule;
+// Zone data from the SD card. The worker owns the buffer, tzifZone is the zone it holds (-1 if none).
+static TzifData tzif;
+static uint8_t *tzifBuffer = nullptr;
+static volatile int32_t tzifZone = -1;
+static int32_t tzifAttempt = -1; // Zone the worker last tried to load
 
 static volatile ConfigItemTime *updTimeHandle;
 static volatile ConfigItemTime *sysTimeHandle;
 static volatile ConfigItemTime *ntpTimeHandle;
 static volatile uint32_t previewMask;
 
-static OSMessageQueue notifQueue;
-static OSMessageQueue timeQueue;
-static OSMessage notifs[NOTIF_QUEUE_SIZE];
-static OSMessage timeUpdates[TIME_QUEUE_SIZE];
-
-static OSThread *notifThread = nullptr;
-static OSThread *timeThread = nullptr;
-static OSThread *settingsThread = nullptr;
-static volatile bool settingsThreadActive;
-static volatile uint32_t fakePress = false;
-
-// From https://github.com/lettier/ntpclient/blob/master/source/c/main.c
-typedef struct WUT_PACKED
-{
-    uint8_t li_vn_mode;      // Eight bits. li, vn, and mode.
-                                // li.   Two bits.   Leap indicator.
-                                // vn.   Three bits. Version number of the protocol.
-                                // mode. Three bits. Client will pick mode 3 for client.
-
-    uint8_t stratum;         // Eight bits. Stratum level of the local clock.
-    uint8_t poll;            // Eight bits. Maximum interval between successive messages.
-    uint8_t precision;       // Eight bits. Precision of the local clock.
-
-    uint32_t rootDelay;      // 32 bits. Total round trip delay time.
-    uint32_t rootDispersion; // 32 bits. Max error aloud from primary clock source.
-    uint32_t refId;          // 32 bits. Reference clock identifier.
-
-    uint32_t refTm_s;        // 32 bits. Reference time-stamp seconds.
-    uint32_t refTm_f;        // 32 bits. Reference time-stamp fraction of a second.
-
-    uint32_t origTm_s;       // 32 bits. Originate time-stamp seconds.
-    uint32_t origTm_f;       // 32 bits. Originate time-stamp fraction of a second.
-
-    uint32_t rxTm_s;         // 32 bits. Received time-stamp seconds.
-    uint32_t rxTm_f;         // 32 bits. Received time-stamp fraction of a second.
-
-    uint32_t txTm_s;         // 32 bits and the most important field the client cares about. Transmit time-stamp seconds.
-    uint32_t txTm_f;         // 32 bits. Transmit time-stamp fraction of a second.
-
-} ntp_packet;              // Total: 384 bits or 48 bytes.
-WUT_CHECK_OFFSET(ntp_packet, 0x01, stratum);
-WUT_CHECK_OFFSET(ntp_packet, 0x02, poll);
-WUT_CHECK_OFFSET(ntp_packet, 0x03, precision);
-WUT_CHECK_OFFSET(ntp_packet, 0x04, rootDelay);
-WUT_CHECK_OFFSET(ntp_packet, 0x08, rootDispersion);
-WUT_CHECK_OFFSET(ntp_packet, 0x0C, refId);
-WUT_CHECK_OFFSET(ntp_packet, 0x10, refTm_s);
-WUT_CHECK_OFFSET(ntp_packet, 0x14, refTm_f);
-WUT_CHECK_OFFSET(ntp_packet, 0x18, origTm_s);
-WUT_CHECK_OFFSET(ntp_packet, 0x1C, origTm_f);
-WUT_CHECK_OFFSET(ntp_packet, 0x20, rxTm_s);
-WUT_CHECK_OFFSET(ntp_packet, 0x24, rxTm_f);
-WUT_CHECK_OFFSET(ntp_packet, 0x28, txTm_s);
-WUT_CHECK_OFFSET(ntp_packet, 0x2C, txTm_f);
-WUT_CHECK_SIZE(ntp_packet, 0x30);
-
-typedef struct
+static OSMessageQueue workerQueue;
+static OSMessage workerMessages[WORKER_QUEUE_SIZE];
+
+// Threads die with the process of the title, so the worker is recreated on every application start.
+// Its control block and stack are reused from the arena instead of the default heap the title uses.
+static OSThread *workerThread = nullptr;
+// The pad and GX2 hooks stay installed for the whole session but bail out after a single load of these
+// flags when there's nothing for them to do, which is the case during normal gameplay.
+static volatile uint32_t hookFlags;
+
+static OSAlarm dstAlarm;
+static OSAlarm workerAlarm;
+static OSAlarm previewAlarm;
+
+// Written by the worker, read by the config menu
+static volatile uint64_t previewNtpOffset; // NTP time minus system time of the last preview sync, 0 if there is none
+static volatile uint32_t previewNextSync;  // System time in seconds of the next preview sync
+static volatile uint32_t previewSecond;    // System time in seconds the preview was last drawn for
+
+static uint8_t notifRing[NOTIF_RING_SIZE] __attribute__((aligned(4)));
+static uint32_t notifHead; // Oldest notification
+static uint32_t notifTail; // Where the next notification goes
+static uint32_t notifUsed; // Bytes in use, including the unused end of the ring when wrapping
+static uint32_t notifRetryInterval;
+
+static volatile uint32_t lastInput;
+static volatile uint32_t lastFrame;
+
+// Only what has to happen before the worker runs is done on the boot path, the rest is done by the worker.
+// How long each step took is kept for measuring the load cost of the plugin.
+typedef enum
 {
-    bool error;
-    char msg[1024];;
-} NOTIFICATION;
+    INIT_STEP_ARENA,     // Boot path
+    INIT_STEP_APP_START, // Boot path, on every application start
+    INIT_STEP_SETTINGS,  // Deferred
+    INIT_STEP_TIMEZONE,  // Deferred
+    INIT_STEP_COUNT,
+} INIT_STEP;
 
-extern "C" int32_t CCRSysSetSystemTime(OSTime time);
-extern "C" bool __OSSetAbsoluteSystemTime(OSTime time);
+static const char *const initStepNames[INIT_STEP_COUNT] = { "arena", "application start", "settings", "timezone" };
+static OSTime initTicks[INIT_STEP_COUNT];
 
-#define get_ip_str(sad) inet_ntoa(reinterpret_cast<sockaddr_in *>(sad->ai_addr)->sin_addr)
+static OSMutex settingsMutex;
+static volatile bool settingsLoaded = false;
 
-static int notifMain(int argc, const char **argv)
+typedef struct
 {
-    (void)argc;
-    (void)argv;
-    OSMessage msg;
-    bool ready;
-
-    NotificationModule_InitLibrary();
-    NotificationModule_SetDefaultValue(NOTIFICATION_MODULE_NOTIFICATION_TYPE_INFO, NOTIFICATION_MODULE_DEFAULT_OPTION_DURATION_BEFORE_FADE_OUT, 3.0f);
-    NotificationModule_SetDefaultValue(NOTIFICATION_MODULE_NOTIFICATION_TYPE_ERROR, NOTIFICATION_MODULE_DEFAULT_OPTION_DURATION_BEFORE_FADE_OUT, 7.0f);
+    int fd;
+    OSTime sent;
+    uint32_t len;
+    char buf[512];
+} HTTP_QUERY;
+
+// Shows the messages of the NTP client through the notification ring
+struct RingNotifier
+{
+    static void info(const char *text);
+    static void error(const char *text);
+};
+
+// The lab build (make LAB=1) samples every server a few times and takes the median of several servers.
+// The normal build is the classic single server SNTP client.
+#ifdef SNTP_LAB_BUILD
+typedef NtpClient<UdpUnicast, MinDelayFilter<4>, MedianSelection<3>, StepDiscipline<250>, RingNotifier> SntpClient;
+#else
+typedef NtpClient<UdpUnicast, NoFilter, FirstSource, StepDiscipline<250>, RingNotifier> SntpClient;
+#endif
+
+// A sync in flight, driven by the workers event loop
+typedef struct
+{
+    bool active;
+    bool preview; // Only measure for the config menus preview, don't touch the clock
+    SYNC_ERRORS errors;
+    SntpClient ntp;
+    HTTP_QUERY http;
+    bool httpDone;
+    bool httpSuccess;
+    OSTime httpStart;
+    OSTime httpTimeout;
+    OSTime httpOffset;
+} SYNC_JOB;
+
+static SYNC_JOB syncJob;
+
+// The last successful sync, used to extrapolate UTC without asking the server again
+typedef struct
+{
+    bool valid;
+    OSTime utc;    // UTC (Wii U epoch) at the time of the sync
+    OSTime sys;    // OSGetSystemTime() at the time of the sync
+    bool precise;  // From NTP, HTTP is too coarse to measure drift against
+    int32_t drift; // Drift of the system clock in parts per billion
+} CLOCK_SAMPLE;
+
+static CLOCK_SAMPLE clockSample;
+
+// Queues a notification for the worker to show once the overlay is ready. Only call this from the worker.
+// Notifications of the same kind coalesce like identical ones, the text of the last one is kept if it fits.
+static void showNotification(bool error, const char *notif, const char *kind = nullptr, uint8_t repeat = 1)
+{
+    NOTIFICATION *entry;
+    uint32_t offset = notifHead;
+    uint32_t size;
 
-    do
+    // Coalesce with an identical notification or one of the same kind still waiting
+    for(uint32_t seen = 0; seen < notifUsed; seen += size)
     {
-        OSReceiveMessage(&notifQueue, &msg, OS_MESSAGE_FLAGS_BLOCKING);
-        if(msg.message == MSG_EXIT)
-            break;
+        entry = reinterpret_cast<NOTIFICATION *>(notifRing + offset);
+        if(entry->length == 0)
+        {
+            size = NOTIF_RING_SIZE - offset;
+            offset = 0;
+            continue;
+        }
 
-        while(NotificationModule_IsOverlayReady(&ready) == NOTIFICATION_MODULE_RESULT_SUCCESS && !ready)
-            OSSleepTicks(OSMillisecondsToTicks(100));
+        bool same;
+        if(kind != nullptr && entry->kind != nullptr)
+            same = strcmp(entry->kind, kind) == 0;
+        else
+            same = strcmp(reinterpret_cast<char *>(entry + 1), notif) == 0;
 
-        if(ready)
+        if(entry->error == error && same)
         {
-            if(static_cast<NOTIFICATION *>(msg.message)->error)
-                NotificationModule_AddErrorNotification(static_cast<NOTIFICATION *>(msg.message)->msg);
-            else
-                NotificationModule_AddInfoNotification(static_cast<NOTIFICATION *>(msg.message)->msg);
+            entry->repeat = entry->repeat + repeat > 0xFF ? 0xFF : entry->repeat + repeat;
+
+            uint32_t length = strnlen(notif, NOTIF_MAX_LENGTH - 1) + 1;
+            // The entry keeps its size, so the ring stays walkable
+            if(length <= entry->length)
+            {
+                OSBlockMove(entry + 1, notif, length - 1, false);
+                reinterpret_cast<char *>(entry + 1)[length - 1] = '\0';
+            }
+
+            return;
         }
 
-        MEMFreeToDefaultHeap(msg.message);
-    } while(1);
+        size = NOTIF_SIZE(entry->length);
+        offset = (offset + size) % NOTIF_RING_SIZE;
+    }
 
-    NotificationModule_DeInitLibrary();
-    return 0;
+    uint32_t length = strnlen(notif, NOTIF_MAX_LENGTH - 1) + 1;
+    size = NOTIF_SIZE(length);
+    uint32_t padding = 0;
+
+    offset = notifTail;
+    if(offset + size > NOTIF_RING_SIZE)
+    {
+        padding = NOTIF_RING_SIZE - offset;
+        offset = 0;
+    }
+
+    if(notifUsed + padding + size > NOTIF_RING_SIZE)
+        return; // Full, drop it
+
+    if(padding != 0)
+        reinterpret_cast<NOTIFICATION *>(notifRing + notifTail)->length = 0;
+
+    entry = reinterpret_cast<NOTIFICATION *>(notifRing + offset);
+    entry->length = length;
+    entry->error = error;
+    entry->repeat = repeat;
+    entry->kind = kind;
+    OSBlockMove(entry + 1, notif, length - 1, false);
+    reinterpret_cast<char *>(entry + 1)[length - 1] = '\0';
+
+    notifTail = (offset + size) % NOTIF_RING_SIZE;
+    notifUsed += padding + size;
 }
 
-static void showNotification(bool error, const char *notif)
+void RingNotifier::info(const char *text)
 {
-    OSMessage msg;
-    msg.message = MEMAllocFromDefaultHeap(sizeof(NOTIFICATION));
-    if(msg.message == nullptr)
-        return;
-
-    static_cast<NOTIFICATION *>(msg.message)->error = error;
-    strncpy(static_cast<NOTIFICATION *>(msg.message)->msg, notif, 1023);
-    static_cast<NOTIFICATION *>(msg.message)->msg[1023] = '\0';
+    showNotification(false, text);
+}
 
-    if(!OSSendMessage(&notifQueue, &msg, OS_MESSAGE_FLAGS_NONE))
-        MEMFreeToDefaultHeap(msg.message);
+void RingNotifier::error(const char *text)
+{
+    showNotification(true, text);
 }
 
-static void showNotificationF(bool error, const char *notif, ...)
+// Days since 2000-01-01 for a date of the proleptic Gregorian calendar.
+static int32_t daysSince2000(int32_t year, uint32_t month, uint32_t day)
 {
-    char msg[1024];
-    va_list va;
-    va_start(va, notif);
-    vsnprintf(msg, 1023, notif, va);
-    va_end(va);
-    showNotification(error, msg);
+    year -= month <= 2;
+    int32_t era = (year >= 0 ? year : year - 399) / 400;
+    uint32_t yoe = year - era * 400;
+    uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int32_t>(doe) - 730425;
 }
 
-static inline bool SetSystemTime(OSTime time)
+// Parses the Date header of a HTTP response ("Date: Sun, 06 Nov 1994 08:49:37 GMT").
+// Returns false if the header is missing or malformed.
+static bool parseHTTPDate(const char *response, uint32_t *seconds)
 {
-    bool res = false;
-    nn::pdm::NotifySetTimeBeginEvent();
+    static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+    for(const char *line = response; line != nullptr; line = strstr(line, "\r\n"))
+    {
+        if(*line == '\r')
+            line += 2;
+
+        if(strncasecmp(line, "Date:", 5) != 0)
+            continue;
 
-    if(CCRSysSetSystemTime(time) == 0)
-        res = __OSSetAbsoluteSystemTime(time);
+        int32_t day, year, hour, minute, second;
+        char month[4];
+        if(sscanf(line + 5, " %*3s, %d %3s %d %d:%d:%d GMT", &day, month, &year, &hour, &minute, &second) != 6)
+            return false;
 
-    nn::pdm::NotifySetTimeEndEvent();
-    return res;
+        const char *m = strstr(months, month);
+        if(m == nullptr || ((m - months) % 3) != 0 || year < 2000 || day < 1 || day > 31)
+            return false;
+
+        *seconds = (daysSince2000(year, ((m - months) / 3) + 1, day) * 86400) + (hour * 3600) + (minute * 60) + second;
+        return true;
+    }
+
+    return false;
 }
 
-static OSTime NTPGetTime()
+static int startHTTPQuery(HTTP_QUERY *query, SYNC_ERRORS *errors)
 {
-    OSTime tick = 0;
-
-    // Get host address by name
     struct addrinfo *addys = NULL;
     struct addrinfo hints;
     OSBlockSet(&hints, 0, sizeof(struct addrinfo));
     hints.ai_family = AF_INET;
-    hints.ai_socktype = SOCK_DGRAM;
-    hints.ai_protocol = IPPROTO_UDP;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
     hints.ai_flags = AI_ADDRCONFIG;
 
+    int ret = getaddrinfo(pluginSettings.httpServer, "80", &hints, &addys);
+    if(ret)
+    {
+        syncError(errors, "SNTP Client: Error resolving host: %s", gai_strerror(ret));
+        return -1;
+    }
+
+    query->fd = openSocket(addys, errors);
+    query->len = 0;
+    query->sent = 0;
+    freeaddrinfo(addys);
+    return query->fd;
+}
+
+static bool sendHTTPQuery(HTTP_QUERY *query, SYNC_ERRORS *errors)
+{
+    int len = snprintf(query->buf, sizeof(query->buf), "HEAD / HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n\r\n", pluginSettings.httpServer);
+    query->sent = OSGetTime();
+    if(write(query->fd, query->buf, len) == len)
+        return true;
+
+    syncError(errors, "SNTP Client: Error writing to %s: %s!", pluginSettings.httpServer, strerror(errno));
+    return false;
+}
+
+// Returns true once the query is finished, *success and *offset are set if the reply is usable.
+static bool readHTTPReply(HTTP_QUERY *query, bool *success, OSTime *offset, SYNC_ERRORS *errors)
+{
+    int ret = read(query->fd, query->buf + query->len, sizeof(query->buf) - 1 - query->len);
+    if(ret < 0)
+    {
+        if(errno == EWOULDBLOCK || errno == EAGAIN)
+            return false;
 
-    // Create the packet
-    ntp_packet packet __attribute__((__aligned__(0x40)));
+        syncError(errors, "SNTP Client: Error reading from %s: %s", pluginSettings.httpServer, strerror(errno));
+        return true;
+    }
 
-    int sockfd = getaddrinfo((char *)ntp_server, "123", &hints, &addys);
-    if(!sockfd)
+    query->len += ret;
+    query->buf[query->len] = '\0';
+    if(ret != 0 && query->len != sizeof(query->buf) - 1 && strstr(query->buf, "\r\n\r\n") == nullptr)
+        return false;
+
+    uint32_t seconds;
+    if(!parseHTTPDate(query->buf, &seconds))
     {
-        // Loop through all IP addys returned by the DNS
-        for(struct addrinfo *addr = addys; addr != NULL; addr = addr->ai_next)
+        syncError(errors, "SNTP Client: Got invalid reply from %s!", pluginSettings.httpServer);
+        return true;
+    }
+
+    // The Date header is truncated to full seconds and was created somewhere between sending the request and
+    // receiving the reply, so assume half a second plus half the round trip time passed since then.
+    OSTime now = OSGetTime();
+    *offset = OSSecondsToTicks(seconds + timezoneOffset) + OSMillisecondsToTicks(500) + ((now - query->sent) / 2) - now;
+    *success = true;
+    return true;
+}
+
+static void startSync(SYNC_JOB *job, bool preview)
+{
+    job->active = true;
+    job->preview = preview;
+    job->errors.count = 0;
+    job->http.fd = -1;
+    job->httpDone = false;
+    job->httpSuccess = false;
+
+    job->ntp.start(pluginSettings.ntpServer, &job->errors);
+    job->httpStart = OSGetSystemTime() + OSMillisecondsToTicks(HTTP_FALLBACK_DELAY);
+}
+
+// Handles timeouts and starts the next queries. Returns false once the sync is finished.
+static bool stepSync(SYNC_JOB *job, OSTime now)
+{
+    if(job->ntp.succeeded())
+        return false;
+
+    // Once HTTP answered only the NTP query in flight may still improve on it, till it times out
+    job->ntp.step(now, &job->errors, !job->httpSuccess);
+
+    // Race the HTTP fallback against slow or blocked NTP and start it right away if NTP can't succeed anymore
+    if(!job->httpDone)
+    {
+        if(job->http.fd == -1)
         {
-            // Reset packet
-            OSBlockSet(&packet, 0, sizeof(packet));
-            // Set the first byte's bits to 00,001,011 for li = 0, vn = 1, and mode = 3.
-            packet.li_vn_mode = (1 << 3) | MODE_CLIENT;
-
-            // Create a socket
-            sockfd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
-            if(sockfd != -1)
+            if(now >= job->httpStart || !job->ntp.busy())
             {
-                // Connect to the server
-                if(connect(sockfd, addr->ai_addr, addr->ai_addrlen) == 0)
-                {
-                    // Send it the NTP packet it wants.
-                    if(write(sockfd, &packet, sizeof(packet)) == sizeof(packet))
-                    {
-                        // Wait and receive the packet back from the server.
-                        if(read(sockfd, &packet, sizeof(packet)) == sizeof(packet))
-                        {
-                            // Basic validity check:
-                            // li != 11
-                            // stratum != 0
-                            // transmit timestamp != 0
-                            if((packet.li_vn_mode & LI_UNSYNC) != LI_UNSYNC && (packet.li_vn_mode & MODE_MASK) == MODE_SERVER && packet.stratum != 0 && (packet.txTm_s | packet.txTm_f))
-                            {
-                                // Adjust timestamp
-                                packet.txTm_s = ntohl(packet.txTm_s);
-                                packet.txTm_s -= NTP_TIMESTAMP_DELTA;
-                                // Convert timezone
-                                packet.txTm_s += timezoneOffset;
-
-                                // Convert seconds to ticks
-                                tick = OSSecondsToTicks(packet.txTm_s);
-
-                                // Convert fraction of seconds
-                                tick += OSNanosecondsToTicks((ntohl(packet.txTm_f) * 1000000000llu) >> 32);
-                                close(sockfd);
-                                break;
-                            }
-
-                            showNotificationF(true, "SNTP Client: Got invalid reply from %s!", get_ip_str(addr));
-                        }
-                        else
-                            showNotificationF(true, "SNTP Client: Error reading from %s: %s", get_ip_str(addr), strerror(errno));
-                    }
-                    else
-                        showNotificationF(true, "SNTP Client: Error writing to %s: %s!", get_ip_str(addr), strerror(errno));
-                }
+                if(startHTTPQuery(&job->http, &job->errors) == -1)
+                    job->httpDone = true;
                 else
-                    showNotificationF(true, "SNTP Client: Error connecting to %s: %s", get_ip_str(addr), strerror(errno));
-
-                close(sockfd);
+                    job->httpTimeout = now + OSMillisecondsToTicks(HTTP_TIMEOUT);
             }
-            else
-                showNotificationF(true, "SNTP Client: Error opening socket: %s", strerror(errno));
-        } // End of IP loop
+        }
+        else if(now >= job->httpTimeout)
+        {
+            syncError(&job->errors, "SNTP Client: Timeout reading from %s", pluginSettings.httpServer);
+            job->httpDone = true;
+        }
+    }
 
-        freeaddrinfo(addys);
+    return job->ntp.busy() || !job->httpDone;
+}
+
+// Adds the sockets the sync waits for and lowers *wakeup to its next timeout.
+static void prepareSyncFds(SYNC_JOB *job, fd_set *readfds, fd_set *writefds, int *maxfd, OSTime *wakeup)
+{
+    job->ntp.prepareFds(readfds, maxfd, wakeup);
+
+    if(job->httpDone)
+        return;
+
+    if(job->http.fd == -1)
+    {
+        if(job->httpStart < *wakeup)
+            *wakeup = job->httpStart;
+
+        return;
     }
-    else
-        showNotificationF(true, "SNTP Client: Error resolving host: %s", gai_strerror(sockfd));
 
-    return tick;
+    FD_SET(job->http.fd, job->http.sent ? readfds : writefds);
+    if(job->http.fd > *maxfd)
+        *maxfd = job->http.fd;
+    if(job->httpTimeout < *wakeup)
+        *wakeup = job->httpTimeout;
 }
 
-static inline void updateTime() {
-    if(enabledSync)
+static void handleSyncFds(SYNC_JOB *job, fd_set *readfds, fd_set *writefds)
+{
+    job->ntp.handleFds(readfds, &job->errors);
+    if(job->ntp.succeeded())
+        return;
+
+    if(job->http.fd != -1 && !job->httpDone)
     {
-        OSMessage msg;
-        msg.message = nullptr;
-        OSSendMessage(&timeQueue, &msg, OS_MESSAGE_FLAGS_NONE);
+        if(FD_ISSET(job->http.fd, writefds))
+            job->httpDone = !sendHTTPQuery(&job->http, &job->errors);
+        else if(FD_ISSET(job->http.fd, readfds))
+            job->httpDone = readHTTPReply(&job->http, &job->httpSuccess, &job->httpOffset, &job->errors);
     }
 }
 
-static int timeThreadMain(int argc, const char **argv)
+// Closes all sockets and returns the local time the servers told or 0.
+static OSTime finishSync(SYNC_JOB *job, bool *precise)
 {
-    (void)argc;
-    (void)argv;
+    job->active = false;
+    if(job->http.fd != -1)
+        close(job->http.fd);
+
+    // NTP is precise to the millisecond while HTTP is off by up to a second, so prefer NTP whenever it answered
+    OSTime offset;
+    *precise = job->ntp.finish(&offset);
+    if(*precise)
+        return OSGetTime() + offset + OSSecondsToTicks(timezoneOffset);
+    if(job->httpSuccess)
+        return OSGetTime() + job->httpOffset;
 
-    OSMessage msg;
-    OSTime time;
-    OSTime tmpTime;
+    return 0;
+}
 
-    do
+static inline void updateTime(bool urgent) {
+    if(pluginSettings.enabledSync)
     {
-        OSReceiveMessage(&timeQueue, &msg, OS_MESSAGE_FLAGS_BLOCKING);
-        if(msg.message == MSG_EXIT)
-            return 0;
+        OSMessage msg;
+        msg.message = urgent ? MSG_SYNC_NOW : MSG_SYNC;
+        OSSendMessage(&workerQueue, &msg, OS_MESSAGE_FLAGS_NONE);
+    }
+}
 
-        time = NTPGetTime(); // Connect to the time server.
-        tmpTime = OSGetTime();
-        if(time == 0)
-            continue;
+// UTC now, extrapolated from the last sync or derived from the local clock if there was none.
+static OSTime getUTC()
+{
+    if(!clockSample.valid)
+        return OSGetTime() - OSSecondsToTicks(timezoneOffset);
 
-        tmpTime = static_cast<OSTime>(abs(time - tmpTime));
+    OSTime elapsed = OSGetSystemTime() - clockSample.sys;
+    return clockSample.utc + elapsed + (((elapsed / 1000) * clockSample.drift) / 1000000);
+}
 
-        if(tmpTime <= static_cast<OSTime>(OSMillisecondsToTicks(250)))
-            continue; // Time difference is within 250 milliseconds, no need to update.
+// HTTP results only re-base the sample, a second of error would swamp the few ppm of drift measured between syncs.
+static void updateClockSample(OSTime utc, OSTime sys, bool precise)
+{
+    if(precise && clockSample.valid && clockSample.precise && sys - clockSample.sys >= static_cast<OSTime>(OSSecondsToTicks(DRIFT_MIN_INTERVAL)))
+    {
+        // Compare what the system clock measured since the last sync with what really passed
+        OSTime measured = sys - clockSample.sys;
+        OSTime drift = (((utc - clockSample.utc) - measured) * 1000000) / (measured / 1000);
+        if(drift >= -DRIFT_MAX && drift <= DRIFT_MAX)
+        {
+            // Remembered across reboots, the next application start writes it
+            clockSample.drift = pluginSettings.drift = drift;
+            settingsMarkDirty(SETTING_DRIFT);
+        }
+    }
 
-        if(SetSystemTime(time))
-            showNotification(false, "Time synced");
-        else
-            showNotification(true, "SNTP Client: Error setting hardware clock!");
-    } while(1);
+    clockSample.utc = utc;
+    clockSample.sys = sys;
+    clockSample.precise = precise;
+    clockSample.valid = true;
 }
 
-static void syncingEnabled(ConfigItemBoolean *item, bool value)
+// Returns the UTC offset in seconds in effect at utc and sets *next to the UTC time of the next DST transition (0 if there is none).
+static int32_t getTimezoneOffset(OSTime utc, OSTime *next)
 {
-    (void)item;
-    // If false, bro is literally a time traveler!
-    WUPS_StoreBool(nullptr, SYNCING_ENABLED_CONFIG_ID, value);
-    enabledSync = value;
+    int64_t change;
+    int64_t seconds = OSTicksToSeconds(utc) + UNIX_TIMESTAMP_DELTA;
+    int32_t offset = tzifZone == pluginSettings.timezone ? tzifOffset(&tzif, seconds, &change) : tzOffset(timezoneRule, seconds, &change);
+    *next = change == 0 ? 0 : OSSecondsToTicks(change - UNIX_TIMESTAMP_DELTA);
+    return offset;
 }
 
-static void changeTimezone(ConfigItemMultipleValues *item, uint32_t value)
+// Sends the message set as the alarms user data to the worker
+static void alarmCallback(OSAlarm *alarm, OSContext *context)
 {
-    (void)item;
-
-    setenv("TZ", timezonesPOSIX[value].valueName, 1);
-    tzset();
-    timezoneOffset = -_timezone;
-    if(_daylight)
-        timezoneOffset += 3600;
+    (void)context;
 
-    timezone = value;
+    OSMessage msg;
+    msg.message = OSGetAlarmUserData(alarm);
+    OSSendMessage(&workerQueue, &msg, OS_MESSAGE_FLAGS_NONE);
 }
 
-static void saveTimezone(ConfigItemMultipleValues *item, uint32_t value)
+static void armDSTAlarm(OSTime utc, OSTime next)
 {
-    (void)item;
-    WUPS_StoreInt(nullptr, TIMEZONE_CONFIG_ID, value);
-    changeTimezone(nullptr, value);
+    OSCancelAlarm(&dstAlarm);
+    if(next == 0)
+        return;
+
+    // The alarm counts system ticks, so correct the UTC delay by the drift
+    OSTime delay = next - utc;
+    delay -= ((delay / 1000) * clockSample.drift) / 1000000;
+    OSSetAlarm(&dstAlarm, delay, alarmCallback);
 }
 
-static void changeNtpServer()
+// Loads the TZif file of the selected zone from the SD card if there is one. Only the worker does file I/O, it
+// replaces the buffer only while tzifZone doesn't match the selected zone, so nobody reads it meanwhile.
+static void loadTzif()
 {
-    WUPS_StoreString(nullptr, NTPSERVER_CONFIG_ID, (const char *)ntp_server);
+    int32_t zone = pluginSettings.timezone;
+    if(zone == tzifAttempt)
+        return;
+
+    tzifAttempt = zone;
+    tzifZone = -1;
+
+    if(tzifBuffer == nullptr)
+    {
+        tzifBuffer = static_cast<uint8_t *>(arenaAlloc(ARENA_POOL_TZIF));
+        if(tzifBuffer == nullptr)
+            return;
+    }
+
+    char path[sizeof(TZIF_PATH) + 64];
+    snprintf(path, sizeof(path), TZIF_PATH "%s", tzdbName(zone));
+    if(tzifLoad(path, tzifBuffer, ARENA_TZIF_SIZE, &tzif))
+        tzifZone = zone;
 }
 
-static OSThread *startThread(const char *name, OSThreadEntryPointFn mainfunc, size_t stacksize, OSThreadAttributes attribs)
+// Re-applies the UTC offset at a DST transition, extrapolating from the last sync instead of asking the server again.
+static void applyDST()
 {
-    OSThread *ost = static_cast<OSThread *>(MEMAllocFromDefaultHeapEx(sizeof(OSThread) + stacksize, 8));
-    if(ost != nullptr)
-    {
-        if(OSCreateThread(ost, mainfunc, 0, nullptr, reinterpret_cast<uint8_t *>(ost) + stacksize + sizeof(OSThread), stacksize, 5, attribs))
-        {
-            OSSetThreadName(ost, name);
-            OSResumeThread(ost);
-            return ost;
-        }
+    loadTzif();
+    OSTime utc = getUTC();
+    OSTime next;
+    int32_t offset = getTimezoneOffset(utc, &next);
 
-        MEMFreeToDefaultHeap(ost);
+    if(offset != timezoneOffset)
+    {
+        timezoneOffset = offset;
+        if(SetSystemTime(utc + OSSecondsToTicks(offset)))
+            showNotification(false, "Time synced");
+        else
+            showNotification(true, "SNTP Client: Error setting hardware clock!");
     }
 
-    return nullptr;
+    armDSTAlarm(utc, next);
 }
 
-static inline void stopThread(OSThread *thread)
+static void completeSync(SYNC_JOB *job)
 {
-    OSJoinThread(thread, nullptr);
-    OSDetachThread(thread);
-    MEMFreeToDefaultHeap(thread);
-}
+    bool preview = job->preview;
+    bool precise;
+    OSTime time = finishSync(job, &precise);
 
-INITIALIZE_PLUGIN() {
-    WUPSStorageError storageRes = WUPS_OpenStorage();
-    // Check if the plugin's settings have been saved before.
-    if(storageRes == WUPS_STORAGE_ERROR_SUCCESS) {
-        if((storageRes = WUPS_GetBool(nullptr, SYNCING_ENABLED_CONFIG_ID, (bool *)&enabledSync)) == WUPS_STORAGE_ERROR_NOT_FOUND)
-            WUPS_StoreBool(nullptr, SYNCING_ENABLED_CONFIG_ID, enabledSync);
+    if(time == 0)
+    {
+        for(uint32_t i = 0; i < job->errors.count; ++i)
+            showNotification(true, job->errors.msg[i], job->errors.kind[i], job->errors.repeat[i]);
 
-        if((storageRes = WUPS_GetInt(nullptr, TIMEZONE_CONFIG_ID, &timezone)) == WUPS_STORAGE_ERROR_NOT_FOUND)
-            WUPS_StoreInt(nullptr, TIMEZONE_CONFIG_ID, timezone);
+        // Still keep DST right
+        if(!preview)
+            applyDST();
 
-        if((storageRes = WUPS_GetString(nullptr, NTPSERVER_CONFIG_ID, (char *)ntp_server, MAX_NTP_SERVER_LENTGH - 1)) == WUPS_STORAGE_ERROR_NOT_FOUND)
-            WUPS_StoreString(nullptr, NTPSERVER_CONFIG_ID, (char *)ntp_server);
+        return;
+    }
 
-        WUPS_CloseStorage(); // Close the storage.
+    if(preview)
+    {
+        OSSetAtomic64(&previewNtpOffset, time - OSGetSystemTime());
+        return;
     }
 
-    changeTimezone(nullptr, timezone);
+    // Keep the sample in UTC and re-evaluate DST with the real time
+    OSTime next;
+    loadTzif();
+    time -= OSSecondsToTicks(timezoneOffset);
+    updateClockSample(time, OSGetSystemTime(), precise);
+    timezoneOffset = getTimezoneOffset(time, &next);
+    armDSTAlarm(time, next);
+    time += OSSecondsToTicks(timezoneOffset);
+
+    SntpClient::discipline(time);
 }
 
-ON_APPLICATION_START()
+// The title is considered idle if nobody touched a controller for a while or if it stopped presenting frames (loading screens, HOME menu).
+static bool isTitleIdle()
 {
-    OSInitMessageQueueEx(&notifQueue, notifs, NOTIF_QUEUE_SIZE, "SNTP Client Notifications");
-    OSInitMessageQueueEx(&timeQueue, timeUpdates, TIME_QUEUE_SIZE, "SNTP Client Time Update Requests");
-
-    notifThread = startThread("SNTP Client Notification Thread", notifMain, 0x2000, OS_THREAD_ATTRIB_AFFINITY_CPU0);
-    timeThread = startThread("SNTP Client Time Update Thread", timeThreadMain, 0x2000, OS_THREAD_ATTRIB_AFFINITY_CPU2);
-
-    updateTime();
+    // Read the timestamps first so they can't be newer than now
+    uint32_t input = lastInput;
+    uint32_t frame = lastFrame;
+    uint32_t now = ACTIVITY_TIME();
+    return now - input >= ACTIVITY_MS(INPUT_IDLE_TIME) || now - frame >= ACTIVITY_MS(FRAME_IDLE_TIME);
 }
 
-ON_APPLICATION_ENDS() {
-    OSMessage msg;
-    msg.message = MSG_EXIT;
+// Shows the queued notifications once the overlay is ready. Returns false if it isn't ready yet.
+static bool showNotifications()
+{
+    if(notifUsed == 0)
+        return true;
 
-    if(timeThread != nullptr)
+    bool ready = false;
+    if(NotificationModule_IsOverlayReady(&ready) == NOTIFICATION_MODULE_RESULT_SUCCESS && !ready)
     {
-        OSSendMessage(&timeQueue, &msg, OS_MESSAGE_FLAGS_BLOCKING);
-        stopThread(timeThread);
-        timeThread = nullptr;
+        // Back off while the title is still starting up
+        if(notifRetryInterval < NOTIF_RETRY_INTERVAL_MAX)
+            notifRetryInterval *= 2;
+
+        return false;
     }
 
-    if(notifThread != nullptr)
+    notifRetryInterval = NOTIF_RETRY_INTERVAL;
+    char text[NOTIF_MAX_LENGTH + 16];
+
+    while(notifUsed != 0)
     {
-        OSSendMessage(&notifQueue, &msg, OS_MESSAGE_FLAGS_BLOCKING);
-        stopThread(notifThread);
-        notifThread = nullptr;
+        NOTIFICATION *entry = reinterpret_cast<NOTIFICATION *>(notifRing + notifHead);
+        if(entry->length == 0)
+        {
+            notifUsed -= NOTIF_RING_SIZE - notifHead;
+            notifHead = 0;
+            continue;
+        }
+
+        if(ready)
+        {
+            const char *notif = reinterpret_cast<char *>(entry + 1);
+            if(entry->repeat > 1)
+            {
+                snprintf(text, sizeof(text), "%s (x%u)", notif, entry->repeat);
+                notif = text;
+            }
+
+            if(entry->error)
+                NotificationModule_AddErrorNotification(notif);
+            else
+                NotificationModule_AddInfoNotification(notif);
+        }
+
+        uint32_t size = NOTIF_SIZE(entry->length);
+        notifHead = (notifHead + size) % NOTIF_RING_SIZE;
+        notifUsed -= size;
     }
+
+    notifHead = notifTail = 0;
+    return true;
+}
+
+// Returns false if another sync is still running, the preview has to try again once it finished
+static bool startPreviewSync()
+{
+    if(syncJob.active)
+        return false;
+
+    previewNextSync = static_cast<uint32_t>(OSGetSystemTime() / OSSecondsToTicks(1)) + PREVIEW_SYNC_INTERVAL;
+    startSync(&syncJob, true);
+    return true;
 }
 
-static int settingsThreadMain(int argc, const char **argv) {
+static void loadSettings();
+
+// The one thread of the plugin. Timers are alarms sending messages, so it only ever waits for messages
+// or, while a sync is in flight, for its sockets.
+static int workerMain(int argc, const char **argv)
+{
     (void)argc;
     (void)argv;
 
-    uint32_t i = 1;
-    OSTime ntpTime = 0;
-    OSTime localTime = 0;
-    OSCalendarTime ct;
-    char timeString[64];
+    OSMessage msg;
+    OSMessageFlags flags;
+    uint32_t pending = 0;
+    bool previewPending = false;
+    bool urgent = false;
+    OSTime deferredSince = 0;
+    OSTime now;
+    OSTime wakeup;
+
+    NotificationModule_InitLibrary();
+    NotificationModule_SetDefaultValue(NOTIFICATION_MODULE_NOTIFICATION_TYPE_INFO, NOTIFICATION_MODULE_DEFAULT_OPTION_DURATION_BEFORE_FADE_OUT, 3.0f);
+    NotificationModule_SetDefaultValue(NOTIFICATION_MODULE_NOTIFICATION_TYPE_ERROR, NOTIFICATION_MODULE_DEFAULT_OPTION_DURATION_BEFORE_FADE_OUT, 7.0f);
 
-    while(settingsThreadActive)
+    loadSettings();
+    tzifAttempt = -1; // The SD card might have changed since the last title
+
+    syncJob.active = false;
+    notifHead = notifTail = notifUsed = 0;
+    notifRetryInterval = NOTIF_RETRY_INTERVAL;
+
+    do
     {
-        if(!--i)
+        now = OSGetSystemTime();
+        wakeup = 0;
+
+        // Network syncs and clock steps are deferred till the title is idle, unless they are urgent or were deferred for too long
+        if(pending != 0 && !syncJob.active)
         {
-            i = 30;
-            ntpTime = NTPGetTime();
-            localTime = OSGetTime();
+            if(urgent || isTitleIdle() || now - deferredSince >= static_cast<OSTime>(OSMillisecondsToTicks(MAX_DEFERRAL)))
+            {
+                // Requests can be queued before this thread loaded the settings or while syncing got disabled, so check again
+                if(pluginSettings.enabledSync)
+                {
+                    if(pending & PENDING_SYNC)
+                    {
+                        startSync(&syncJob, false);
+                        now = OSGetSystemTime(); // Resolving the host might have taken a while
+                    }
+                    else
+                        applyDST();
+                }
+
+                pending = 0;
+                urgent = false;
+                OSAndAtomic(&hookFlags, ~HOOK_TRACK_ACTIVITY);
+            }
+            else
+                wakeup = now + OSMillisecondsToTicks(DEFERRAL_POLL_INTERVAL);
         }
-        else
+
+        if(previewPending && !syncJob.active)
+            previewPending = !startPreviewSync();
+
+        if(syncJob.active && !stepSync(&syncJob, now))
         {
-            if(ntpTime)
-                ntpTime += OSSecondsToTicks(1);
+            completeSync(&syncJob);
+            continue; // Start whatever waited for the sync to finish
+        }
 
-            localTime += OSSecondsToTicks(1);
+        if(!showNotifications() && (wakeup == 0 || now + static_cast<OSTime>(OSMillisecondsToTicks(notifRetryInterval)) < wakeup))
+            wakeup = now + OSMillisecondsToTicks(notifRetryInterval);
 
+        if(syncJob.active)
+        {
+            // Wait for the sockets but keep handling messages in between
+            fd_set readfds;
+            fd_set writefds;
+            FD_ZERO(&readfds);
+            FD_ZERO(&writefds);
+            int maxfd = -1;
+            OSTime deadline = now + OSMillisecondsToTicks(SOCKET_POLL_INTERVAL);
+            if(wakeup != 0 && wakeup < deadline)
+                deadline = wakeup;
+
+            prepareSyncFds(&syncJob, &readfds, &writefds, &maxfd, &deadline);
+
+            struct timeval tv;
+            deadline = deadline > now ? OSTicksToMicroseconds(deadline - now) : 0;
+            tv.tv_sec = deadline / 1000000;
+            tv.tv_usec = deadline % 1000000;
+
+            if(maxfd == -1)
+                OSSleepTicks(OSMicrosecondsToTicks(deadline));
+            else if(select(maxfd + 1, &readfds, &writefds, nullptr, &tv) > 0)
+                handleSyncFds(&syncJob, &readfds, &writefds);
+
+            flags = OS_MESSAGE_FLAGS_NONE;
+        }
+        else
+        {
+            if(wakeup != 0)
+                OSSetAlarm(&workerAlarm, wakeup - now, alarmCallback);
 
+            flags = OS_MESSAGE_FLAGS_BLOCKING;
         }
 
-        if(previewMask)
+        while(OSReceiveMessage(&workerQueue, &msg, flags))
         {
-            snprintf(timeString, 63, "Next update in %u seconds", i);
-            WUPSConfigItem_SetDisplayName(updTimeHandle->handle, timeString);
-
-            if(ntpTime)
+            flags = OS_MESSAGE_FLAGS_NONE;
+
+            if(msg.message == MSG_EXIT)
+                goto exit;
+            else if(msg.message == MSG_TIMER)
+                continue;
+            else if(msg.message == MSG_PREVIEW)
+                previewPending = !startPreviewSync();
+            else if(msg.message == MSG_PREVIEW_START)
             {
-                OSTicksToCalendarTime(ntpTime, &ct);
-                snprintf(timeString, 63, "Current NTP Time: %04d-%02d-%02d %02d:%02d:%02d:%04d:%04d\n", ct.tm_year, ct.tm_mon + 1, ct.tm_mday, ct.tm_hour, ct.tm_min, ct.tm_sec, ct.tm_msec, ct.tm_usec);
-                WUPSConfigItem_SetDisplayName(ntpTimeHandle->handle, timeString);
+                previewPending = !startPreviewSync();
+                OSSetPeriodicAlarm(&previewAlarm, OSSecondsToTicks(PREVIEW_SYNC_INTERVAL), OSSecondsToTicks(PREVIEW_SYNC_INTERVAL), alarmCallback);
             }
-            else
-                WUPSConfigItem_SetDisplayName(ntpTimeHandle->handle, "Current NTP Time: N/A");
-
-            OSTicksToCalendarTime(localTime, &ct);
-            snprintf(timeString, 63, "Current SYS Time: %04d-%02d-%02d %02d:%02d:%02d:%04d:%04d\n", ct.tm_year, ct.tm_mon + 1, ct.tm_mday, ct.tm_hour, ct.tm_min, ct.tm_sec, ct.tm_msec, ct.tm_usec);
-            WUPSConfigItem_SetDisplayName(sysTimeHandle->handle, timeString);
+            else if(msg.message == MSG_PREVIEW_STOP)
+            {
+                OSCancelAlarm(&previewAlarm);
+                previewPending = false;
+            }
+            else if(msg.message == MSG_DST || msg.message == MSG_SYNC || msg.message == MSG_SYNC_NOW)
+            {
+                if(pending == 0)
+                {
+                    deferredSince = OSGetSystemTime();
+                    // Activity isn't tracked while nothing is deferred, so start over from now
+                    lastInput = lastFrame = ACTIVITY_TIME();
+                    OSOrAtomic(&hookFlags, HOOK_TRACK_ACTIVITY);
+                }
 
-            // Update screen with a fake button press
-            fakePress = true;
+                if(msg.message == MSG_DST)
+                    pending |= PENDING_DST; // A sync re-applies DST, too
+                else
+                {
+                    pending |= PENDING_SYNC;
+                    if(msg.message == MSG_SYNC_NOW)
+                        urgent = true;
+                }
+            }
         }
 
-        OSSleepTicks(OSSecondsToTicks(1));
+        OSCancelAlarm(&workerAlarm);
+    } while(1);
+
+exit:
+    OSAndAtomic(&hookFlags, ~HOOK_TRACK_ACTIVITY);
+    OSCancelAlarm(&workerAlarm);
+    OSCancelAlarm(&previewAlarm);
+    if(syncJob.active)
+    {
+        bool precise;
+        finishSync(&syncJob, &precise);
+    }
+
+    tzifZone = -1;
+    if(tzifBuffer != nullptr)
+    {
+        arenaFree(ARENA_POOL_TZIF, tzifBuffer);
+        tzifBuffer = nullptr;
     }
 
+    NotificationModule_DeInitLibrary();
     return 0;
 }
 
+static void syncingEnabled(ConfigItemBoolean *item, bool value)
+{
+    (void)item;
+    // If false, bro is literally a time traveler!
+    pluginSettings.enabledSync = value;
+    settingsMarkDirty(SETTING_ENABLED_SYNC);
+}
+
+static void changeTimezone(ConfigItemTimezone *item, uint32_t value)
+{
+    (void)item;
+
+    if(value >= TZDB_ZONE_COUNT)
+        value = DEFAULT_TIMEZONE;
+
+    timezoneRule = tzdbRule(value);
+    pluginSettings.timezone = value;
+
+    // Without a sync to extrapolate from assume the clock shows standard time
+    if(!clockSample.valid)
+        timezoneOffset = timezoneRule->stdOffset;
+
+    OSTime next;
+    timezoneOffset = getTimezoneOffset(getUTC(), &next);
+}
+
+static void saveTimezone(ConfigItemTimezone *item, uint32_t value)
+{
+    (void)item;
+    changeTimezone(nullptr, value);
+    settingsMarkDirty(SETTING_TIMEZONE);
+}
+
+static void changeNtpServer()
+{
+    settingsMarkDirty(SETTING_NTP_SERVER);
+}
+
+static void changeHttpServer()
+{
+    settingsMarkDirty(SETTING_HTTP_SERVER);
+}
+
+// Records how long an init step took. Steps on the boot path get reported if they exceed the budget.
+static void endInitStep(INIT_STEP step, OSTime start, bool eager)
+{
+    initTicks[step] = OSGetSystemTime() - start;
+    uint32_t us = static_cast<uint32_t>(OSTicksToMicroseconds(initTicks[step]));
+
+    if(eager && us > INIT_BUDGET)
+        OSReport("SNTP Client: Init step %s took %u us, budget is %u us\n", initStepNames[step], us, INIT_BUDGET);
+#ifdef DEBUG
+    else
+        OSReport("SNTP Client: Init step %s took %u us\n", initStepNames[step], us);
+#endif
+}
+
+// Nothing needs the settings before the first sync, so the worker loads them instead of INITIALIZE_PLUGIN.
+// The config menu might get opened first, so it calls this, too.
+static void loadSettings()
+{
+    if(settingsLoaded)
+        return;
+
+    OSLockMutex(&settingsMutex);
+    if(!settingsLoaded)
+    {
+        OSTime start = OSGetSystemTime();
+        settingsLoad();
+        if(pluginSettings.drift >= -DRIFT_MAX && pluginSettings.drift <= DRIFT_MAX)
+            clockSample.drift = pluginSettings.drift;
+
+        endInitStep(INIT_STEP_SETTINGS, start, false);
+
+        start = OSGetSystemTime();
+        changeTimezone(nullptr, pluginSettings.timezone);
+        endInitStep(INIT_STEP_TIMEZONE, start, false);
+
+        settingsLoaded = true;
+    }
+
+    OSUnlockMutex(&settingsMutex);
+}
+
+static OSThread *startThread(const char *name, OSThreadEntryPointFn mainfunc, OSThreadAttributes attribs)
+{
+    uint8_t *mem = (uint8_t *)arenaAlloc(ARENA_POOL_THREAD);
+    if(mem == nullptr)
+        return nullptr;
+
+    OSThread *thread = (OSThread *)mem;
+    uint8_t *stack = mem + ((sizeof(OSThread) + 15) & ~15);
+    if(!OSCreateThread(thread, mainfunc, 0, nullptr, stack + ARENA_THREAD_STACK_SIZE, ARENA_THREAD_STACK_SIZE, 5, attribs))
+    {
+        arenaFree(ARENA_POOL_THREAD, mem);
+        return nullptr;
+    }
+
+    OSSetThreadName(thread, name);
+    OSResumeThread(thread);
+    return thread;
+}
+
+static inline void stopThread(OSThread *thread)
+{
+    OSJoinThread(thread, nullptr);
+    arenaFree(ARENA_POOL_THREAD, thread);
+}
+
+static void sendToWorker(void *message)
+{
+    if(workerThread == nullptr)
+        return;
+
+    OSMessage msg;
+    msg.message = message;
+    OSSendMessage(&workerQueue, &msg, OS_MESSAGE_FLAGS_BLOCKING);
+}
+
+INITIALIZE_PLUGIN() {
+    OSTime start = OSGetSystemTime();
+    arenaInit();
+    OSInitMutexEx(&settingsMutex, "SNTP Client Settings Mutex");
+    endInitStep(INIT_STEP_ARENA, start, true);
+}
+
+ON_APPLICATION_START()
+{
+    OSTime start = OSGetSystemTime();
+    OSInitMessageQueueEx(&workerQueue, workerMessages, WORKER_QUEUE_SIZE, "SNTP Client Worker Queue");
+
+    OSCreateAlarmEx(&dstAlarm, "SNTP Client DST Alarm");
+    OSSetAlarmUserData(&dstAlarm, MSG_DST);
+    OSCreateAlarmEx(&workerAlarm, "SNTP Client Worker Alarm");
+    OSSetAlarmUserData(&workerAlarm, MSG_TIMER);
+    OSCreateAlarmEx(&previewAlarm, "SNTP Client Preview Alarm");
+    OSSetAlarmUserData(&previewAlarm, MSG_PREVIEW);
+
+    workerThread = startThread("SNTP Client Worker Thread", workerMain, OS_THREAD_ATTRIB_AFFINITY_CPU2);
+
+    updateTime(false);
+    endInitStep(INIT_STEP_APP_START, start, true);
+}
+
+ON_APPLICATION_ENDS() {
+    OSCancelAlarm(&dstAlarm);
+
+    if(workerThread != nullptr)
+    {
+        sendToWorker(MSG_EXIT);
+        stopThread(workerThread);
+        workerThread = nullptr;
+    }
+
+    // Checkpoint for runtime state like the drift
+    settingsFlush();
+
+#ifdef DEBUG
+    arenaReport();
+#endif
+}
+
 WUPS_GET_CONFIG() {
-    if(WUPS_OpenStorage() != WUPS_STORAGE_ERROR_SUCCESS)
-        return 0;
+    loadSettings();
 
     WUPSConfigHandle settings;
     WUPSConfig_CreateHandled(&settings, "Wii U Time Sync");
@@ -504,58 +1088,129 @@ WUPS_GET_CONFIG() {
     WUPSConfigCategoryHandle preview;
     WUPSConfig_AddCategoryByNameHandled(settings, "Preview Time", &preview);
 
-    WUPSConfigItemBoolean_AddToCategoryHandled(settings, config, SYNCING_ENABLED_CONFIG_ID, "Syncing Enabled", enabledSync, &syncingEnabled);
-    WUPSConfigItemMultipleValues_AddToCategoryHandled(settings, config, TIMEZONE_CONFIG_ID, "Timezone", timezone, timezonesReadable, sizeof(timezonesReadable) / sizeof(timezonesReadable[0]), &saveTimezone);
-    WUPSConfigItemNtpServer_AddToCategoryHandled(settings, config, NTPSERVER_CONFIG_ID, "NTP Server", (char *)ntp_server, &changeNtpServer);
+    WUPSConfigItemBoolean_AddToCategoryHandled(settings, config, SYNCING_ENABLED_CONFIG_ID, "Syncing Enabled", pluginSettings.enabledSync, &syncingEnabled);
+    WUPSConfigItemTimezone_AddToCategoryHandled(settings, config, TIMEZONE_CONFIG_ID, "Timezone", pluginSettings.timezone, &saveTimezone);
+    WUPSConfigItemNtpServer_AddToCategoryHandled(settings, config, NTPSERVER_CONFIG_ID, "NTP Server", pluginSettings.ntpServer, DEFAULT_NTP_SERVER, &changeNtpServer);
+    WUPSConfigItemNtpServer_AddToCategoryHandled(settings, config, HTTPSERVER_CONFIG_ID, "HTTP Fallback Server", pluginSettings.httpServer, DEFAULT_HTTP_SERVER, &changeHttpServer);
 
     previewMask = 0;
+    previewSecond = 0;
+    OSSetAtomic64(&previewNtpOffset, 0);
     sysTimeHandle = WUPSConfigItemTime_AddToCategoryHandled(settings, preview, "sysTime", "Current SYS Time: Loading...", &previewMask, 1);
     ntpTimeHandle = WUPSConfigItemTime_AddToCategoryHandled(settings, preview, "ntpTime", "Current NTP Time: Loading...", &previewMask, 2);
     updTimeHandle = WUPSConfigItemTime_AddToCategoryHandled(settings, preview, "updTime", "Next update in 30 seconds", &previewMask, 4);
 
-    settingsThreadActive = true;
-    settingsThread = startThread("SNTP Client Settings Thread", settingsThreadMain, 0x4000, OS_THREAD_ATTRIB_AFFINITY_CPU1);
+    OSOrAtomic(&hookFlags, HOOK_CONFIG);
+    sendToWorker(MSG_PREVIEW_START);
 
     return settings;
 }
 
 WUPS_CONFIG_CLOSED() {
-    settingsThreadActive = false;
-    updateTime();
-    WUPS_CloseStorage(); // Save all changes.
-    if(settingsThread != nullptr)
+    OSAndAtomic(&hookFlags, ~HOOK_CONFIG);
+    sendToWorker(MSG_PREVIEW_STOP);
+    // The title is paused while the config menu is open, so don't wait for it to become idle
+    updateTime(true);
+    settingsFlush();
+}
+
+// Called from the pad polls of the config menu, right before it handles input and draws. The preview
+// is rebuilt from the system clock and the last sync once the shown second changes, so it can't drift.
+// Returns true if the preview changed.
+static bool refreshPreview()
+{
+    OSTime now = OSGetSystemTime();
+    uint32_t second = static_cast<uint32_t>(now / OSSecondsToTicks(1));
+    uint32_t shown = previewSecond;
+    if(previewMask == 0 || second == shown || !OSCompareAndSwapAtomic(&previewSecond, shown, second))
+        return false;
+
+    OSCalendarTime ct;
+    char timeString[64];
+    uint32_t next = previewNextSync;
+    snprintf(timeString, 63, "Next update in %u seconds", next > second ? next - second : 0);
+    WUPSConfigItem_SetDisplayName(updTimeHandle->handle, timeString);
+
+    OSTime offset = static_cast<OSTime>(OSGetAtomic64(&previewNtpOffset));
+    if(offset != 0)
     {
-        stopThread(settingsThread);
-        settingsThread = nullptr;
+        OSTicksToCalendarTime(now + offset, &ct);
+        snprintf(timeString, 63, "Current NTP Time: %04d-%02d-%02d %02d:%02d:%02d:%04d:%04d\n", ct.tm_year, ct.tm_mon + 1, ct.tm_mday, ct.tm_hour, ct.tm_min, ct.tm_sec, ct.tm_msec, ct.tm_usec);
+        WUPSConfigItem_SetDisplayName(ntpTimeHandle->handle, timeString);
     }
+    else
+        WUPSConfigItem_SetDisplayName(ntpTimeHandle->handle, "Current NTP Time: N/A");
+
+    OSTicksToCalendarTime(OSGetTime(), &ct);
+    snprintf(timeString, 63, "Current SYS Time: %04d-%02d-%02d %02d:%02d:%02d:%04d:%04d\n", ct.tm_year, ct.tm_mon + 1, ct.tm_mday, ct.tm_hour, ct.tm_min, ct.tm_sec, ct.tm_msec, ct.tm_usec);
+    WUPSConfigItem_SetDisplayName(sysTimeHandle->handle, timeString);
+    return true;
 }
 
 DECL_FUNCTION(int32_t, VPADRead, VPADChan chan, VPADStatus *buffers, uint32_t count, VPADReadError *outError)
 {
     int32_t result = real_VPADRead(chan, buffers, count, outError);
+    uint32_t flags = hookFlags;
+    if(flags == 0)
+        return result;
+
+    if((flags & HOOK_TRACK_ACTIVITY) && *outError == VPAD_READ_SUCCESS && (buffers->hold || buffers->tpNormal.touched))
+        lastInput = ACTIVITY_TIME();
 
-    if(settingsThreadActive && *outError == VPAD_READ_SUCCESS && OSCompareAndSwapAtomic(&fakePress, true, false) && !buffers->trigger)
+    // The config menu only redraws on input, so a changed preview is brought to screen with a press of a button
+    // it ignores. Never while real buttons are down, so it can't mix with what the user does.
+    if((flags & HOOK_CONFIG) && *outError == VPAD_READ_SUCCESS && refreshPreview() && !buffers->hold)
         buffers->trigger = VPAD_BUTTON_MINUS;
 
     return result;
 }
 WUPS_MUST_REPLACE(VPADRead, WUPS_LOADER_LIBRARY_VPAD, VPADRead);
 
+// Each extension reports its buttons in its own part of the status, the core ones only cover the Wii Remote itself
+static uint32_t kpadHold(const KPADStatus *data)
+{
+    switch(data->extensionType)
+    {
+        case WPAD_EXT_CLASSIC:
+        case WPAD_EXT_MPLUS_CLASSIC:
+            return data->classic.hold;
+        case WPAD_EXT_PRO_CONTROLLER:
+            return data->pro.hold;
+        default:
+            return data->hold;
+    }
+}
+
 DECL_FUNCTION(int32_t, KPADReadEx, KPADChan chan, KPADStatus *data, uint32_t size, KPADError *error)
 {
     int32_t result = real_KPADReadEx(chan, data, size, error);
-    if(settingsThreadActive && result > 0 && *error == KPAD_ERROR_OK && data->extensionType != 0xFF && OSCompareAndSwapAtomic(&fakePress, true, false))
+    uint32_t flags = hookFlags;
+    if(flags == 0)
+        return result;
+
+    if((flags & HOOK_TRACK_ACTIVITY) && result > 0 && *error == KPAD_ERROR_OK && kpadHold(data) != 0)
+        lastInput = ACTIVITY_TIME();
+
+    if((flags & HOOK_CONFIG) && result > 0 && *error == KPAD_ERROR_OK && data->extensionType != 0xFF && refreshPreview())
     {
         if(data->extensionType == WPAD_EXT_CORE || data->extensionType == WPAD_EXT_NUNCHUK)
         {
-            if(!data->trigger)
-                data->trigger = VPAD_BUTTON_MINUS;
+            if(!data->hold)
+                data->trigger = WPAD_BUTTON_MINUS;
         }
-        else if(!data->classic.trigger)
+        else if(!kpadHold(data))
             data->classic.trigger = WPAD_CLASSIC_BUTTON_MINUS;
     }
 
-
     return result;
 }
 WUPS_MUST_REPLACE(KPADReadEx, WUPS_LOADER_LIBRARY_PADSCORE, KPADReadEx);
+
+DECL_FUNCTION(void, GX2SwapScanBuffers, void)
+{
+    if(hookFlags & HOOK_TRACK_ACTIVITY)
+        lastFrame = ACTIVITY_TIME();
+
+    real_GX2SwapScanBuffers();
+}
+WUPS_MUST_REPLACE(GX2SwapScanBuffers, WUPS_LOADER_LIBRARY_GX2, GX2SwapScanBuffers);
@@ -0,0 +1,565 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <coreinit/memory.h>
+#include <coreinit/time.h>
+#include <nn/pdm.h>
+#include <wut.h>
+
+// The NTP client, put together from policies at compile time:
+//
+// Transport  - How queries reach a server and replies come back (UdpUnicast, UdpBroadcast)
+// Filter     - Which of the samples of one server is used (NoFilter, MinDelayFilter)
+// Selection  - Which of the servers is trusted (FirstSource, MedianSelection)
+// Discipline - What happens with the result (StepDiscipline)
+// Notifier   - Where messages go, provided by the user of the client
+//
+// Only the policies a build selects get instantiated, everything else compiles away.
+
+// Seconds between 1900 (NTP epoch) and 2000 (Wii U epoch)
+#define NTP_TIMESTAMP_DELTA 3155673600llu
+
+// Timeouts in milliseconds
+#define NTP_TIMEOUT 2000
+// Broadcast servers send every 64 seconds by default
+#define NTP_BROADCAST_TIMEOUT 70000
+
+#define LI_UNSYNC 0xc0
+#define MODE_MASK 0x07
+#define MODE_CLIENT 0x03
+#define MODE_SERVER 0x04
+#define MODE_BROADCAST 0x05
+
+#define get_ip_str(sad) inet_ntoa(reinterpret_cast<sockaddr_in *>(sad->ai_addr)->sin_addr)
+
+extern "C" int32_t CCRSysSetSystemTime(OSTime time);
+extern "C" bool __OSSetAbsoluteSystemTime(OSTime time);
+
+// From https://github.com/lettier/ntpclient/blob/master/source/c/main.c
+typedef struct WUT_PACKED
+{
+    uint8_t li_vn_mode;      // Eight bits. li, vn, and mode.
+                                // li.   Two bits.   Leap indicator.
+                                // vn.   Three bits. Version number of the protocol.
+                                // mode. Three bits. Client will pick mode 3 for client.
+
+    uint8_t stratum;         // Eight bits. Stratum level of the local clock.
+    uint8_t poll;            // Eight bits. Maximum interval between successive messages.
+    uint8_t precision;       // Eight bits. Precision of the local clock.
+
+    uint32_t rootDelay;      // 32 bits. Total round trip delay time.
+    uint32_t rootDispersion; // 32 bits. Max error aloud from primary clock source.
+    uint32_t refId;          // 32 bits. Reference clock identifier.
+
+    uint32_t refTm_s;        // 32 bits. Reference time-stamp seconds.
+    uint32_t refTm_f;        // 32 bits. Reference time-stamp fraction of a second.
+
+    uint32_t origTm_s;       // 32 bits. Originate time-stamp seconds.
+    uint32_t origTm_f;       // 32 bits. Originate time-stamp fraction of a second.
+
+    uint32_t rxTm_s;         // 32 bits. Received time-stamp seconds.
+    uint32_t rxTm_f;         // 32 bits. Received time-stamp fraction of a second.
+
+    uint32_t txTm_s;         // 32 bits and the most important field the client cares about. Transmit time-stamp seconds.
+    uint32_t txTm_f;         // 32 bits. Transmit time-stamp fraction of a second.
+
+} ntp_packet;              // Total: 384 bits or 48 bytes.
+WUT_CHECK_OFFSET(ntp_packet, 0x01, stratum);
+WUT_CHECK_OFFSET(ntp_packet, 0x02, poll);
+WUT_CHECK_OFFSET(ntp_packet, 0x03, precision);
+WUT_CHECK_OFFSET(ntp_packet, 0x04, rootDelay);
+WUT_CHECK_OFFSET(ntp_packet, 0x08, rootDispersion);
+WUT_CHECK_OFFSET(ntp_packet, 0x0C, refId);
+WUT_CHECK_OFFSET(ntp_packet, 0x10, refTm_s);
+WUT_CHECK_OFFSET(ntp_packet, 0x14, refTm_f);
+WUT_CHECK_OFFSET(ntp_packet, 0x18, origTm_s);
+WUT_CHECK_OFFSET(ntp_packet, 0x1C, origTm_f);
+WUT_CHECK_OFFSET(ntp_packet, 0x20, rxTm_s);
+WUT_CHECK_OFFSET(ntp_packet, 0x24, rxTm_f);
+WUT_CHECK_OFFSET(ntp_packet, 0x28, txTm_s);
+WUT_CHECK_OFFSET(ntp_packet, 0x2C, txTm_f);
+WUT_CHECK_SIZE(ntp_packet, 0x30);
+
+#define SYNC_ERRORS_MAX 4
+
+// Errors are collected while the sources race and only shown if none of them succeeded. Errors of the same
+// kind (format string) collapse into one that names the last server, so a pool doesn't fill it by itself.
+typedef struct
+{
+    uint32_t count;
+    const char *kind[SYNC_ERRORS_MAX];
+    uint8_t repeat[SYNC_ERRORS_MAX];
+    char msg[SYNC_ERRORS_MAX][128];
+} SYNC_ERRORS;
+
+static inline bool SetSystemTime(OSTime time)
+{
+    bool res = false;
+    nn::pdm::NotifySetTimeBeginEvent();
+
+    if(CCRSysSetSystemTime(time) == 0)
+        res = __OSSetAbsoluteSystemTime(time);
+
+    nn::pdm::NotifySetTimeEndEvent();
+    return res;
+}
+
+static void syncError(SYNC_ERRORS *errors, const char *err, ...)
+{
+    uint32_t i = 0;
+    while(i < errors->count && strcmp(errors->kind[i], err) != 0)
+        ++i;
+
+    if(i == SYNC_ERRORS_MAX)
+        return;
+
+    if(i == errors->count)
+    {
+        errors->kind[i] = err;
+        errors->repeat[i] = 0;
+        ++errors->count;
+    }
+
+    if(errors->repeat[i] != 0xFF)
+        ++errors->repeat[i];
+
+    va_list va;
+    va_start(va, err);
+    vsnprintf(errors->msg[i], sizeof(errors->msg[0]), err, va);
+    va_end(va);
+}
+
+static int openSocket(struct addrinfo *addr, SYNC_ERRORS *errors)
+{
+    int sockfd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+    if(sockfd == -1)
+    {
+        syncError(errors, "SNTP Client: Error opening socket: %s", strerror(errno));
+        return -1;
+    }
+
+    fcntl(sockfd, F_SETFL, fcntl(sockfd, F_GETFL, 0) | O_NONBLOCK);
+    if(connect(sockfd, addr->ai_addr, addr->ai_addrlen) == 0 || errno == EINPROGRESS)
+        return sockfd;
+
+    syncError(errors, "SNTP Client: Error connecting to %s: %s", get_ip_str(addr), strerror(errno));
+    close(sockfd);
+    return -1;
+}
+
+// One measurement: how far the servers clock is ahead of OSGetTime() (UTC, so without the timezone) and the round trip it took
+typedef struct
+{
+    OSTime offset;
+    OSTime delay;
+} NTP_SAMPLE;
+
+// Converts a NTP timestamp to ticks since the Wii U epoch
+static inline OSTime ntpToTicks(uint32_t seconds, uint32_t fraction)
+{
+    OSTime tick = OSSecondsToTicks(static_cast<OSTime>(ntohl(seconds) - NTP_TIMESTAMP_DELTA));
+    return tick + OSNanosecondsToTicks((ntohl(fraction) * 1000000000llu) >> 32);
+}
+
+// Asks every address the server name resolves to, one after the other
+class UdpUnicast
+{
+public:
+    static const uint8_t replyMode = MODE_SERVER;
+    static const bool hasOrigin = true; // Replies answer our own query, so the round trip is known
+    static const uint32_t timeout = NTP_TIMEOUT;
+
+    bool start(const char *server, SYNC_ERRORS *errors)
+    {
+        struct addrinfo hints;
+        OSBlockSet(&hints, 0, sizeof(struct addrinfo));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        hints.ai_protocol = IPPROTO_UDP;
+        hints.ai_flags = AI_ADDRCONFIG;
+
+        addys = nullptr;
+        int ret = getaddrinfo(server, "123", &hints, &addys);
+        if(ret)
+            syncError(errors, "SNTP Client: Error resolving host: %s", gai_strerror(ret));
+
+        addr = addys;
+        return addr != nullptr;
+    }
+
+    bool hasCandidate() const { return addr != nullptr; }
+    void nextCandidate() { addr = addr->ai_next; }
+    const char *peer() const { return get_ip_str(addr); }
+
+    // Returns the socket the reply will arrive on or -1, *sent is the origin timestamp of the query
+    int send(OSTime *sent, SYNC_ERRORS *errors)
+    {
+        int sockfd = openSocket(addr, errors);
+        if(sockfd == -1)
+            return -1;
+
+        ntp_packet packet __attribute__((__aligned__(0x40)));
+        OSBlockSet(&packet, 0, sizeof(packet));
+        // Set the first byte's bits to 00,001,011 for li = 0, vn = 1, and mode = 3.
+        packet.li_vn_mode = (1 << 3) | MODE_CLIENT;
+
+        // As close to the write as possible, everything in between would count as network delay
+        *sent = OSGetTime();
+        if(write(sockfd, &packet, sizeof(packet)) == sizeof(packet))
+            return sockfd;
+
+        syncError(errors, "SNTP Client: Error writing to %s: %s!", peer(), strerror(errno));
+        close(sockfd);
+        return -1;
+    }
+
+    void finish()
+    {
+        if(addys != nullptr)
+            freeaddrinfo(addys);
+
+        addys = addr = nullptr;
+    }
+
+private:
+    struct addrinfo *addys;
+    struct addrinfo *addr;
+};
+
+// Listens for a broadcast server on the local network instead of asking one
+class UdpBroadcast
+{
+public:
+    static const uint8_t replyMode = MODE_BROADCAST;
+    static const bool hasOrigin = false;
+    static const uint32_t timeout = NTP_BROADCAST_TIMEOUT;
+
+    bool start(const char *server, SYNC_ERRORS *errors)
+    {
+        (void)server;
+        (void)errors;
+        listening = false;
+        return true;
+    }
+
+    bool hasCandidate() const { return !listening; }
+    void nextCandidate() { listening = true; }
+    const char *peer() const { return "broadcast"; }
+
+    int send(OSTime *sent, SYNC_ERRORS *errors)
+    {
+        (void)sent;
+        int sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if(sockfd == -1)
+        {
+            syncError(errors, "SNTP Client: Error opening socket: %s", strerror(errno));
+            return -1;
+        }
+
+        struct sockaddr_in local;
+        OSBlockSet(&local, 0, sizeof(local));
+        local.sin_family = AF_INET;
+        local.sin_port = htons(123);
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+
+        fcntl(sockfd, F_SETFL, fcntl(sockfd, F_GETFL, 0) | O_NONBLOCK);
+        if(bind(sockfd, reinterpret_cast<struct sockaddr *>(&local), sizeof(local)) == 0)
+            return sockfd;
+
+        syncError(errors, "SNTP Client: Error listening for broadcasts: %s", strerror(errno));
+        close(sockfd);
+        return -1;
+    }
+
+    void finish() { }
+
+private:
+    bool listening;
+};
+
+// Takes the first sample of a server
+class NoFilter
+{
+public:
+    void reset() { count = 0; }
+    void add(const NTP_SAMPLE &s) { sample = s; count = 1; }
+    bool full() const { return count != 0; }
+    bool result(NTP_SAMPLE *out) const
+    {
+        if(count == 0)
+            return false;
+
+        *out = sample;
+        return true;
+    }
+
+private:
+    uint32_t count;
+    NTP_SAMPLE sample;
+};
+
+// Queries a server Samples times and keeps the sample with the shortest round trip, it's the least affected by queueing
+template<uint32_t Samples>
+class MinDelayFilter
+{
+public:
+    void reset() { count = 0; }
+    void add(const NTP_SAMPLE &s)
+    {
+        if(count++ == 0 || s.delay < best.delay)
+            best = s;
+    }
+    bool full() const { return count >= Samples; }
+    bool result(NTP_SAMPLE *out) const
+    {
+        if(count == 0)
+            return false;
+
+        *out = best;
+        return true;
+    }
+
+private:
+    uint32_t count;
+    NTP_SAMPLE best;
+};
+
+// Trusts the first server that answers
+class FirstSource
+{
+public:
+    void reset() { count = 0; }
+    void add(const NTP_SAMPLE &s) { sample = s; count = 1; }
+    bool done() const { return count != 0; }
+    bool result(NTP_SAMPLE *out) const
+    {
+        if(count == 0)
+            return false;
+
+        *out = sample;
+        return true;
+    }
+
+private:
+    uint32_t count;
+    NTP_SAMPLE sample;
+};
+
+// Asks up to Sources servers and takes the median offset, so a single falseticker can't pull the clock
+template<uint32_t Sources>
+class MedianSelection
+{
+public:
+    void reset() { count = 0; }
+    void add(const NTP_SAMPLE &s)
+    {
+        // Keep them sorted by offset
+        uint32_t i = count++;
+        for(; i > 0 && samples[i - 1].offset > s.offset; --i)
+            samples[i] = samples[i - 1];
+
+        samples[i] = s;
+    }
+    bool done() const { return count >= Sources; }
+    bool result(NTP_SAMPLE *out) const
+    {
+        if(count == 0)
+            return false;
+
+        *out = samples[(count - 1) / 2];
+        return true;
+    }
+
+private:
+    uint32_t count;
+    NTP_SAMPLE samples[Sources];
+};
+
+// Steps the clock if it's off by more than ThresholdMs
+template<uint32_t ThresholdMs>
+class StepDiscipline
+{
+public:
+    template<class Notifier>
+    static void apply(OSTime time)
+    {
+        OSTime diff = time - OSGetTime();
+        if(diff < 0)
+            diff = -diff;
+
+        if(diff <= static_cast<OSTime>(OSMillisecondsToTicks(ThresholdMs)))
+            return;
+
+        if(SetSystemTime(time))
+            Notifier::info("Time synced");
+        else
+            Notifier::error("SNTP Client: Error setting hardware clock!");
+    }
+};
+
+// A sync of the NTP side, driven by the workers event loop: step() starts queries and handles timeouts,
+// prepareFds() / handleFds() wait for and read the replies.
+template<class Transport, class Filter, class Selection, class Discipline, class Notifier>
+class NtpClient
+{
+public:
+    void start(const char *server, SYNC_ERRORS *errors)
+    {
+        fd = -1;
+        filter.reset();
+        selection.reset();
+        transport.start(server, errors);
+    }
+
+    // True while a query is in flight
+    bool busy() const { return fd != -1; }
+    bool succeeded() const { return selection.done(); }
+
+    // Times out the query in flight. New queries are only sent while query is true, so a sync that already
+    // got its time elsewhere still gives the one in flight a chance but never waits for more.
+    void step(OSTime now, SYNC_ERRORS *errors, bool query = true)
+    {
+        if(selection.done())
+            return;
+
+        if(fd != -1 && now >= timeout)
+        {
+            syncError(errors, "SNTP Client: Timeout reading from %s", transport.peer());
+            close(fd);
+            fd = -1;
+            nextCandidate();
+        }
+
+        while(query && fd == -1 && transport.hasCandidate() && !selection.done())
+        {
+            fd = transport.send(&sent, errors);
+            if(fd == -1)
+                nextCandidate();
+            else
+                timeout = now + OSMillisecondsToTicks(Transport::timeout);
+        }
+    }
+
+    void prepareFds(fd_set *readfds, int *maxfd, OSTime *wakeup) const
+    {
+        if(fd == -1)
+            return;
+
+        FD_SET(fd, readfds);
+        if(fd > *maxfd)
+            *maxfd = fd;
+        if(timeout < *wakeup)
+            *wakeup = timeout;
+    }
+
+    void handleFds(fd_set *readfds, SYNC_ERRORS *errors)
+    {
+        if(fd == -1 || !FD_ISSET(fd, readfds))
+            return;
+
+        NTP_SAMPLE sample;
+        bool valid = readReply(&sample, errors);
+        close(fd);
+        fd = -1;
+
+        if(!valid)
+        {
+            nextCandidate();
+            return;
+        }
+
+        filter.add(sample);
+        if(filter.full())
+            nextCandidate(); // Otherwise the next step() asks the same server again
+    }
+
+    // Closes everything, *offset is the offset to OSGetTime() the servers agreed on
+    bool finish(OSTime *offset)
+    {
+        if(fd != -1)
+            close(fd);
+
+        fd = -1;
+        transport.finish();
+
+        // Not enough sources answered, go with what's there
+        NTP_SAMPLE sample;
+        if(filter.result(&sample))
+        {
+            selection.add(sample);
+            filter.reset();
+        }
+
+        if(!selection.result(&sample))
+            return false;
+
+        *offset = sample.offset;
+        return true;
+    }
+
+    static void discipline(OSTime time) { Discipline::template apply<Notifier>(time); }
+
+private:
+    // Hands what the filter got from the current server over to the selection and moves on
+    void nextCandidate()
+    {
+        NTP_SAMPLE sample;
+        if(filter.result(&sample))
+            selection.add(sample);
+
+        filter.reset();
+        transport.nextCandidate();
+    }
+
+    bool readReply(NTP_SAMPLE *sample, SYNC_ERRORS *errors)
+    {
+        ntp_packet packet __attribute__((__aligned__(0x40)));
+        if(read(fd, &packet, sizeof(packet)) != sizeof(packet))
+        {
+            syncError(errors, "SNTP Client: Error reading from %s: %s", transport.peer(), strerror(errno));
+            return false;
+        }
+
+        OSTime received = OSGetTime();
+
+        // Basic validity check:
+        // li != 11
+        // stratum != 0
+        // transmit timestamp != 0
+        if((packet.li_vn_mode & LI_UNSYNC) == LI_UNSYNC || (packet.li_vn_mode & MODE_MASK) != Transport::replyMode || packet.stratum == 0 || !(packet.txTm_s | packet.txTm_f))
+        {
+            syncError(errors, "SNTP Client: Got invalid reply from %s!", transport.peer());
+            return false;
+        }
+
+        OSTime transmitted = ntpToTicks(packet.txTm_s, packet.txTm_f);
+        if(!Transport::hasOrigin || !(packet.rxTm_s | packet.rxTm_f))
+        {
+            sample->offset = transmitted - received;
+            sample->delay = 0;
+            return true;
+        }
+
+        // On-wire calculation of RFC 5905, so the network delay doesn't end up in the offset
+        OSTime serverReceived = ntpToTicks(packet.rxTm_s, packet.rxTm_f);
+        sample->offset = ((serverReceived - sent) + (transmitted - received)) / 2;
+        sample->delay = (received - sent) - (transmitted - serverReceived);
+        return true;
+    }
+
+    Transport transport;
+    Filter filter;
+    Selection selection;
+    int fd;
+    OSTime sent;
+    OSTime timeout;
+};
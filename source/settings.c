@@ -0,0 +1,78 @@
+#include "settings.h"
+#include <coreinit/atomic.h>
+#include <wups.h>
+
+PluginSettings pluginSettings = {
+    .enabledSync = true,
+    .timezone    = DEFAULT_TIMEZONE,
+    .ntpServer   = DEFAULT_NTP_SERVER,
+    .httpServer  = DEFAULT_HTTP_SERVER,
+    .drift       = 0,
+};
+
+static volatile uint32_t dirtySettings;
+
+// Storage has to be open already
+static void writeSettings(uint32_t settings)
+{
+    if(settings & SETTING_ENABLED_SYNC)
+        WUPS_StoreBool(NULL, SYNCING_ENABLED_CONFIG_ID, pluginSettings.enabledSync);
+    if(settings & SETTING_TIMEZONE)
+        WUPS_StoreInt(NULL, TIMEZONE_CONFIG_ID, pluginSettings.timezone);
+    if(settings & SETTING_NTP_SERVER)
+        WUPS_StoreString(NULL, NTPSERVER_CONFIG_ID, pluginSettings.ntpServer);
+    if(settings & SETTING_HTTP_SERVER)
+        WUPS_StoreString(NULL, HTTPSERVER_CONFIG_ID, pluginSettings.httpServer);
+    if(settings & SETTING_DRIFT)
+        WUPS_StoreInt(NULL, DRIFT_CONFIG_ID, pluginSettings.drift);
+}
+
+void settingsLoad(void)
+{
+    if(WUPS_OpenStorage() != WUPS_STORAGE_ERROR_SUCCESS)
+        return;
+
+    // Settings that haven't been saved before get their defaults stored
+    uint32_t missing = 0;
+    if(WUPS_GetBool(NULL, SYNCING_ENABLED_CONFIG_ID, &pluginSettings.enabledSync) == WUPS_STORAGE_ERROR_NOT_FOUND)
+        missing |= SETTING_ENABLED_SYNC;
+    if(WUPS_GetInt(NULL, TIMEZONE_CONFIG_ID, &pluginSettings.timezone) == WUPS_STORAGE_ERROR_NOT_FOUND)
+        missing |= SETTING_TIMEZONE;
+    if(WUPS_GetString(NULL, NTPSERVER_CONFIG_ID, pluginSettings.ntpServer, MAX_NTP_SERVER_LENTGH - 1) == WUPS_STORAGE_ERROR_NOT_FOUND)
+        missing |= SETTING_NTP_SERVER;
+    if(WUPS_GetString(NULL, HTTPSERVER_CONFIG_ID, pluginSettings.httpServer, MAX_NTP_SERVER_LENTGH - 1) == WUPS_STORAGE_ERROR_NOT_FOUND)
+        missing |= SETTING_HTTP_SERVER;
+    if(WUPS_GetInt(NULL, DRIFT_CONFIG_ID, &pluginSettings.drift) == WUPS_STORAGE_ERROR_NOT_FOUND)
+        missing |= SETTING_DRIFT;
+
+    writeSettings(missing | OSSwapAtomic(&dirtySettings, 0));
+    WUPS_CloseStorage();
+}
+
+void settingsMarkDirty(uint32_t settings)
+{
+    OSOrAtomic(&dirtySettings, settings);
+}
+
+// Writes all changed settings at once. Returns false if they couldn't be written, they stay dirty then.
+bool settingsFlush(void)
+{
+    uint32_t dirty = OSSwapAtomic(&dirtySettings, 0);
+    if(dirty == 0)
+        return true;
+
+    if(WUPS_OpenStorage() != WUPS_STORAGE_ERROR_SUCCESS)
+    {
+        OSOrAtomic(&dirtySettings, dirty);
+        return false;
+    }
+
+    writeSettings(dirty);
+    if(WUPS_CloseStorage() != WUPS_STORAGE_ERROR_SUCCESS)
+    {
+        OSOrAtomic(&dirtySettings, dirty);
+        return false;
+    }
+
+    return true;
+}
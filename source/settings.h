@@ -0,0 +1,44 @@
+#pragma once
+#include "ConfigItemNtpServer.h"
+#include <wut.h>
+
+// In memory copy of everything the plugin keeps in the WUPS storage. Changes are only marked dirty here and
+// written in one batch by settingsFlush(), so scrolling through settings doesn't hit the SD card every time.
+
+#define SYNCING_ENABLED_CONFIG_ID "enabledSync"
+#define TIMEZONE_CONFIG_ID "timezone"
+#define NTPSERVER_CONFIG_ID "ntpServer"
+#define HTTPSERVER_CONFIG_ID "httpServer"
+#define DRIFT_CONFIG_ID "drift"
+
+#define DEFAULT_TIMEZONE 321
+#define DEFAULT_NTP_SERVER "pool.ntp.org"
+#define DEFAULT_HTTP_SERVER "www.google.com"
+
+#define SETTING_ENABLED_SYNC 0x01
+#define SETTING_TIMEZONE 0x02
+#define SETTING_NTP_SERVER 0x04
+#define SETTING_HTTP_SERVER 0x08
+#define SETTING_DRIFT 0x10
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct PluginSettings {
+    bool enabledSync;
+    int32_t timezone;
+    char ntpServer[MAX_NTP_SERVER_LENTGH];
+    char httpServer[MAX_NTP_SERVER_LENTGH];
+    int32_t drift; // Drift of the system clock in parts per billion, measured at runtime
+} PluginSettings;
+
+extern PluginSettings pluginSettings;
+
+void settingsLoad(void);
+void settingsMarkDirty(uint32_t settings);
+bool settingsFlush(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,863 +0,0 @@
-#pragma once
-
-#include <cstdint>
-#include <map>
-#include <string>
-
-// From https://github.com/jdlambert/micro_tz_db/blob/master/zones.c
-
-ConfigItemMultipleValuesPair timezonesReadable[425]{
-    {0, (char *)"Africa/Abidjan"},
-    {1, (char *)"Africa/Accra"},
-    {2, (char *)"Africa/Addis_Ababa"},
-    {3, (char *)"Africa/Algiers"},
-    {4, (char *)"Africa/Asmara"},
-    {5, (char *)"Africa/Bamako"},
-    {6, (char *)"Africa/Bangui"},
-    {7, (char *)"Africa/Banjul"},
-    {8, (char *)"Africa/Bissau"},
-    {9, (char *)"Africa/Blantyre"},
-    {10, (char *)"Africa/Brazzaville"},
-    {11, (char *)"Africa/Bujumbura"},
-    {12, (char *)"Africa/Cairo"},
-    {13, (char *)"Africa/Casablanca"},
-    {14, (char *)"Africa/Ceuta"},
-    {15, (char *)"Africa/Conakry"},
-    {16, (char *)"Africa/Dakar"},
-    {17, (char *)"Africa/Dar_es_Salaam"},
-    {18, (char *)"Africa/Djibouti"},
-    {19, (char *)"Africa/Douala"},
-    {20, (char *)"Africa/El_Aaiun"},
-    {21, (char *)"Africa/Freetown"},
-    {22, (char *)"Africa/Gaborone"},
-    {23, (char *)"Africa/Harare"},
-    {24, (char *)"Africa/Johannesburg"},
-    {25, (char *)"Africa/Juba"},
-    {26, (char *)"Africa/Kampala"},
-    {27, (char *)"Africa/Khartoum"},
-    {28, (char *)"Africa/Kigali"},
-    {29, (char *)"Africa/Kinshasa"},
-    {30, (char *)"Africa/Lagos"},
-    {31, (char *)"Africa/Libreville"},
-    {32, (char *)"Africa/Lome"},
-    {33, (char *)"Africa/Luanda"},
-    {34, (char *)"Africa/Lubumbashi"},
-    {35, (char *)"Africa/Lusaka"},
-    {36, (char *)"Africa/Malabo"},
-    {37, (char *)"Africa/Maputo"},
-    {38, (char *)"Africa/Maseru"},
-    {39, (char *)"Africa/Mbabane"},
-    {40, (char *)"Africa/Mogadishu"},
-    {41, (char *)"Africa/Monrovia"},
-    {42, (char *)"Africa/Nairobi"},
-    {43, (char *)"Africa/Ndjamena"},
-    {44, (char *)"Africa/Niamey"},
-    {45, (char *)"Africa/Nouakchott"},
-    {46, (char *)"Africa/Ouagadougou"},
-    {47, (char *)"Africa/Porto-Novo"},
-    {48, (char *)"Africa/Sao_Tome"},
-    {49, (char *)"Africa/Tripoli"},
-    {50, (char *)"Africa/Tunis"},
-    {51, (char *)"Africa/Windhoek"},
-    {52, (char *)"America/Adak"},
-    {53, (char *)"America/Anchorage"},
-    {54, (char *)"America/Anguilla"},
-    {55, (char *)"America/Antigua"},
-    {56, (char *)"America/Araguaina"},
-    {57, (char *)"America/Argentina/Buenos_Aires"},
-    {58, (char *)"America/Argentina/Catamarca"},
-    {59, (char *)"America/Argentina/Cordoba"},
-    {60, (char *)"America/Argentina/Jujuy"},
-    {61, (char *)"America/Argentina/La_Rioja"},
-    {62, (char *)"America/Argentina/Mendoza"},
-    {63, (char *)"America/Argentina/Rio_Gallegos"},
-    {64, (char *)"America/Argentina/Salta"},
-    {65, (char *)"America/Argentina/San_Juan"},
-    {66, (char *)"America/Argentina/San_Luis"},
-    {67, (char *)"America/Argentina/Tucuman"},
-    {68, (char *)"America/Argentina/Ushuaia"},
-    {69, (char *)"America/Aruba"},
-    {70, (char *)"America/Asuncion"},
-    {71, (char *)"America/Atikokan"},
-    {72, (char *)"America/Bahia"},
-    {73, (char *)"America/Bahia_Banderas"},
-    {74, (char *)"America/Barbados"},
-    {75, (char *)"America/Belem"},
-    {76, (char *)"America/Belize"},
-    {77, (char *)"America/Blanc-Sablon"},
-    {78, (char *)"America/Boa_Vista"},
-    {79, (char *)"America/Bogota"},
-    {80, (char *)"America/Boise"},
-    {81, (char *)"America/Cambridge_Bay"},
-    {82, (char *)"America/Campo_Grande"},
-    {83, (char *)"America/Cancun"},
-    {84, (char *)"America/Caracas"},
-    {85, (char *)"America/Cayenne"},
-    {86, (char *)"America/Cayman"},
-    {87, (char *)"America/Chicago"},
-    {88, (char *)"America/Chihuahua"},
-    {89, (char *)"America/Costa_Rica"},
-    {90, (char *)"America/Creston"},
-    {91, (char *)"America/Cuiaba"},
-    {92, (char *)"America/Curacao"},
-    {93, (char *)"America/Danmarkshavn"},
-    {94, (char *)"America/Dawson"},
-    {95, (char *)"America/Dawson_Creek"},
-    {96, (char *)"America/Denver"},
-    {97, (char *)"America/Detroit"},
-    {98, (char *)"America/Dominica"},
-    {99, (char *)"America/Edmonton"},
-    {100, (char *)"America/Eirunepe"},
-    {101, (char *)"America/El_Salvador"},
-    {102, (char *)"America/Fortaleza"},
-    {103, (char *)"America/Fort_Nelson"},
-    {104, (char *)"America/Glace_Bay"},
-    {105, (char *)"America/Godthab"},
-    {106, (char *)"America/Goose_Bay"},
-    {107, (char *)"America/Grand_Turk"},
-    {108, (char *)"America/Grenada"},
-    {109, (char *)"America/Guadeloupe"},
-    {110, (char *)"America/Guatemala"},
-    {111, (char *)"America/Guayaquil"},
-    {112, (char *)"America/Guyana"},
-    {113, (char *)"America/Halifax"},
-    {114, (char *)"America/Havana"},
-    {115, (char *)"America/Hermosillo"},
-    {116, (char *)"America/Indiana/Indianapolis"},
-    {117, (char *)"America/Indiana/Knox"},
-    {118, (char *)"America/Indiana/Marengo"},
-    {119, (char *)"America/Indiana/Petersburg"},
-    {120, (char *)"America/Indiana/Tell_City"},
-    {121, (char *)"America/Indiana/Vevay"},
-    {122, (char *)"America/Indiana/Vincennes"},
-    {123, (char *)"America/Indiana/Winamac"},
-    {124, (char *)"America/Inuvik"},
-    {125, (char *)"America/Iqaluit"},
-    {126, (char *)"America/Jamaica"},
-    {127, (char *)"America/Juneau"},
-    {128, (char *)"America/Kentucky/Louisville"},
-    {129, (char *)"America/Kentucky/Monticello"},
-    {130, (char *)"America/Kralendijk"},
-    {131, (char *)"America/La_Paz"},
-    {132, (char *)"America/Lima"},
-    {133, (char *)"America/Los_Angeles"},
-    {134, (char *)"America/Lower_Princes"},
-    {135, (char *)"America/Maceio"},
-    {136, (char *)"America/Managua"},
-    {137, (char *)"America/Manaus"},
-    {138, (char *)"America/Marigot"},
-    {139, (char *)"America/Martinique"},
-    {140, (char *)"America/Matamoros"},
-    {141, (char *)"America/Mazatlan"},
-    {142, (char *)"America/Menominee"},
-    {143, (char *)"America/Merida"},
-    {144, (char *)"America/Metlakatla"},
-    {145, (char *)"America/Mexico_City"},
-    {146, (char *)"America/Miquelon"},
-    {147, (char *)"America/Moncton"},
-    {148, (char *)"America/Monterrey"},
-    {149, (char *)"America/Montevideo"},
-    {150, (char *)"America/Montreal"},
-    {151, (char *)"America/Montserrat"},
-    {152, (char *)"America/Nassau"},
-    {153, (char *)"America/New_York"},
-    {154, (char *)"America/Nipigon"},
-    {155, (char *)"America/Nome"},
-    {156, (char *)"America/Noronha"},
-    {157, (char *)"America/North_Dakota/Beulah"},
-    {158, (char *)"America/North_Dakota/Center"},
-    {159, (char *)"America/North_Dakota/New_Salem"},
-    {160, (char *)"America/Ojinaga"},
-    {161, (char *)"America/Panama"},
-    {162, (char *)"America/Pangnirtung"},
-    {163, (char *)"America/Paramaribo"},
-    {164, (char *)"America/Phoenix"},
-    {165, (char *)"America/Port-au-Prince"},
-    {166, (char *)"America/Port_of_Spain"},
-    {167, (char *)"America/Porto_Velho"},
-    {168, (char *)"America/Puerto_Rico"},
-    {169, (char *)"America/Punta_Arenas"},
-    {170, (char *)"America/Rainy_River"},
-    {171, (char *)"America/Rankin_Inlet"},
-    {172, (char *)"America/Recife"},
-    {173, (char *)"America/Regina"},
-    {174, (char *)"America/Resolute"},
-    {175, (char *)"America/Rio_Branco"},
-    {176, (char *)"America/Santarem"},
-    {177, (char *)"America/Santiago"},
-    {178, (char *)"America/Santo_Domingo",},
-    {179, (char *)"America/Sao_Paulo"},
-    {180, (char *)"America/Scoresbysund"},
-    {181, (char *)"America/Sitka"},
-    {182, (char *)"America/St_Barthelemy"},
-    {183, (char *)"America/St_Johns"},
-    {184, (char *)"America/St_Kitts"},
-    {185, (char *)"America/St_Lucia"},
-    {186, (char *)"America/St_Thomas"},
-    {187, (char *)"America/St_Vincent"},
-    {188, (char *)"America/Swift_Current"},
-    {189, (char *)"America/Tegucigalpa"},
-    {190, (char *)"America/Thule"},
-    {191, (char *)"America/Thunder_Bay"},
-    {192, (char *)"America/Tijuana"},
-    {193, (char *)"America/Toronto"},
-    {194, (char *)"America/Tortola"},
-    {195, (char *)"America/Vancouver"},
-    {196, (char *)"America/Whitehorse"},
-    {197, (char *)"America/Winnipeg"},
-    {198, (char *)"America/Yakutat"},
-    {199, (char *)"America/Yellowknife"},
-    {200, (char *)"Antarctica/Casey"},
-    {201, (char *)"Antarctica/Davis"},
-    {202, (char *)"Antarctica/DumontDUrville"},
-    {203, (char *)"Antarctica/Macquarie"},
-    {204, (char *)"Antarctica/Mawson"},
-    {205, (char *)"Antarctica/McMurdo"},
-    {206, (char *)"Antarctica/Palmer"},
-    {207, (char *)"Antarctica/Rothera"},
-    {208, (char *)"Antarctica/Syowa"},
-    {209, (char *)"Antarctica/Troll"},
-    {210, (char *)"Antarctica/Vostok"},
-    {211, (char *)"Arctic/Longyearbyen"},
-    {212, (char *)"Asia/Aden"},
-    {213, (char *)"Asia/Almaty"},
-    {214, (char *)"Asia/Amman"},
-    {215, (char *)"Asia/Anadyr"},
-    {216, (char *)"Asia/Aqtau"},
-    {217, (char *)"Asia/Aqtobe"},
-    {218, (char *)"Asia/Ashgabat"},
-    {219, (char *)"Asia/Atyrau"},
-    {220, (char *)"Asia/Baghdad"},
-    {221, (char *)"Asia/Bahrain"},
-    {222, (char *)"Asia/Baku"},
-    {223, (char *)"Asia/Bangkok"},
-    {224, (char *)"Asia/Barnaul"},
-    {225, (char *)"Asia/Beirut"},
-    {226, (char *)"Asia/Bishkek"},
-    {227, (char *)"Asia/Brunei"},
-    {228, (char *)"Asia/Chita"},
-    {229, (char *)"Asia/Choibalsan"},
-    {230, (char *)"Asia/Colombo"},
-    {231, (char *)"Asia/Damascus"},
-    {232, (char *)"Asia/Dhaka"},
-    {233, (char *)"Asia/Dili"},
-    {234, (char *)"Asia/Dubai"},
-    {235, (char *)"Asia/Dushanbe"},
-    {236, (char *)"Asia/Famagusta"},
-    {237, (char *)"Asia/Gaza"},
-    {238, (char *)"Asia/Hebron"},
-    {239, (char *)"Asia/Ho_Chi_Minh"},
-    {240, (char *)"Asia/Hong_Kong"},
-    {241, (char *)"Asia/Hovd"},
-    {242, (char *)"Asia/Irkutsk"},
-    {243, (char *)"Asia/Jakarta"},
-    {244, (char *)"Asia/Jayapura"},
-    {245, (char *)"Asia/Jerusalem"},
-    {246, (char *)"Asia/Kabul"},
-    {247, (char *)"Asia/Kamchatka"},
-    {248, (char *)"Asia/Karachi"},
-    {249, (char *)"Asia/Kathmandu"},
-    {250, (char *)"Asia/Khandyga"},
-    {251, (char *)"Asia/Kolkata"},
-    {252, (char *)"Asia/Krasnoyarsk"},
-    {253, (char *)"Asia/Kuala_Lumpur"},
-    {254, (char *)"Asia/Kuching"},
-    {255, (char *)"Asia/Kuwait"},
-    {256, (char *)"Asia/Macau"},
-    {257, (char *)"Asia/Magadan"},
-    {258, (char *)"Asia/Makassar"},
-    {259, (char *)"Asia/Manila"},
-    {260, (char *)"Asia/Muscat"},
-    {261, (char *)"Asia/Nicosia"},
-    {262, (char *)"Asia/Novokuznetsk"},
-    {263, (char *)"Asia/Novosibirsk"},
-    {264, (char *)"Asia/Omsk"},
-    {265, (char *)"Asia/Oral"},
-    {266, (char *)"Asia/Phnom_Penh"},
-    {267, (char *)"Asia/Pontianak"},
-    {268, (char *)"Asia/Pyongyang"},
-    {269, (char *)"Asia/Qatar"},
-    {270, (char *)"Asia/Qyzylorda"},
-    {271, (char *)"Asia/Riyadh"},
-    {272, (char *)"Asia/Sakhalin"},
-    {273, (char *)"Asia/Samarkand"},
-    {274, (char *)"Asia/Seoul"},
-    {275, (char *)"Asia/Shanghai"},
-    {276, (char *)"Asia/Singapore"},
-    {277, (char *)"Asia/Srednekolymsk"},
-    {278, (char *)"Asia/Taipei"},
-    {279, (char *)"Asia/Tashkent"},
-    {280, (char *)"Asia/Tbilisi"},
-    {281, (char *)"Asia/Tehran"},
-    {282, (char *)"Asia/Thimphu"},
-    {283, (char *)"Asia/Tokyo"},
-    {284, (char *)"Asia/Tomsk"},
-    {285, (char *)"Asia/Ulaanbaatar"},
-    {286, (char *)"Asia/Urumqi"},
-    {287, (char *)"Asia/Ust-Nera"},
-    {288, (char *)"Asia/Vientiane"},
-    {289, (char *)"Asia/Vladivostok"},
-    {290, (char *)"Asia/Yakutsk"},
-    {291, (char *)"Asia/Yangon"},
-    {292, (char *)"Asia/Yekaterinburg"},
-    {293, (char *)"Asia/Yerevan"},
-    {294, (char *)"Atlantic/Azores"},
-    {295, (char *)"Atlantic/Bermuda"},
-    {296, (char *)"Atlantic/Canary"},
-    {297, (char *)"Atlantic/Cape_Verde"},
-    {298, (char *)"Atlantic/Faroe"},
-    {299, (char *)"Atlantic/Madeira"},
-    {300, (char *)"Atlantic/Reykjavik"},
-    {301, (char *)"Atlantic/South_Georgia"},
-    {302, (char *)"Atlantic/Stanley"},
-    {303, (char *)"Atlantic/St_Helena"},
-    {304, (char *)"Australia/Adelaide"},
-    {305, (char *)"Australia/Brisbane"},
-    {306, (char *)"Australia/Broken_Hill"},
-    {307, (char *)"Australia/Currie"},
-    {308, (char *)"Australia/Darwin"},
-    {309, (char *)"Australia/Eucla"},
-    {310, (char *)"Australia/Hobart"},
-    {311, (char *)"Australia/Lindeman"},
-    {312, (char *)"Australia/Lord_Howe"},
-    {313, (char *)"Australia/Melbourne"},
-    {314, (char *)"Australia/Perth"},
-    {315, (char *)"Australia/Sydney"},
-    {316, (char *)"Europe/Amsterdam"},
-    {317, (char *)"Europe/Andorra"},
-    {318, (char *)"Europe/Astrakhan"},
-    {319, (char *)"Europe/Athens"},
-    {320, (char *)"Europe/Belgrade"},
-    {321, (char *)"Europe/Berlin"},
-    {322, (char *)"Europe/Bratislava"},
-    {323, (char *)"Europe/Brussels"},
-    {324, (char *)"Europe/Bucharest"},
-    {325, (char *)"Europe/Budapest"},
-    {326, (char *)"Europe/Busingen"},
-    {327, (char *)"Europe/Chisinau"},
-    {328, (char *)"Europe/Copenhagen"},
-    {329, (char *)"Europe/Dublin"},
-    {330, (char *)"Europe/Gibraltar"},
-    {331, (char *)"Europe/Guernsey"},
-    {332, (char *)"Europe/Helsinki"},
-    {333, (char *)"Europe/Isle_of_Man"},
-    {334, (char *)"Europe/Istanbul"},
-    {335, (char *)"Europe/Jersey"},
-    {336, (char *)"Europe/Kaliningrad"},
-    {337, (char *)"Europe/Kiev"},
-    {338, (char *)"Europe/Kirov"},
-    {339, (char *)"Europe/Lisbon"},
-    {340, (char *)"Europe/Ljubljana"},
-    {341, (char *)"Europe/London"},
-    {342, (char *)"Europe/Luxembourg"},
-    {343, (char *)"Europe/Madrid"},
-    {344, (char *)"Europe/Malta"},
-    {345, (char *)"Europe/Mariehamn"},
-    {346, (char *)"Europe/Minsk"},
-    {347, (char *)"Europe/Monaco"},
-    {348, (char *)"Europe/Moscow"},
-    {349, (char *)"Europe/Oslo"},
-    {350, (char *)"Europe/Paris"},
-    {351, (char *)"Europe/Podgorica"},
-    {352, (char *)"Europe/Prague"},
-    {353, (char *)"Europe/Riga"},
-    {354, (char *)"Europe/Rome"},
-    {355, (char *)"Europe/Samara"},
-    {356, (char *)"Europe/San_Marino"},
-    {357, (char *)"Europe/Sarajevo"},
-    {358, (char *)"Europe/Saratov"},
-    {359, (char *)"Europe/Simferopol"},
-    {360, (char *)"Europe/Skopje"},
-    {361, (char *)"Europe/Sofia"},
-    {362, (char *)"Europe/Stockholm"},
-    {363, (char *)"Europe/Tallinn"},
-    {364, (char *)"Europe/Tirane"},
-    {365, (char *)"Europe/Ulyanovsk"},
-    {366, (char *)"Europe/Uzhgorod"},
-    {367, (char *)"Europe/Vaduz"},
-    {368, (char *)"Europe/Vatican"},
-    {369, (char *)"Europe/Vienna"},
-    {370, (char *)"Europe/Vilnius"},
-    {371, (char *)"Europe/Volgograd"},
-    {372, (char *)"Europe/Warsaw"},
-    {373, (char *)"Europe/Zagreb"},
-    {374, (char *)"Europe/Zaporozhye"},
-    {375, (char *)"Europe/Zurich"},
-    {376, (char *)"Indian/Antananarivo"},
-    {377, (char *)"Indian/Chagos"},
-    {378, (char *)"Indian/Christmas"},
-    {379, (char *)"Indian/Cocos"},
-    {380, (char *)"Indian/Comoro"},
-    {381, (char *)"Indian/Kerguelen"},
-    {382, (char *)"Indian/Mahe"},
-    {383, (char *)"Indian/Maldives"},
-    {384, (char *)"Indian/Mauritius"},
-    {385, (char *)"Indian/Mayotte"},
-    {386, (char *)"Indian/Reunion"},
-    {387, (char *)"Pacific/Apia"},
-    {388, (char *)"Pacific/Auckland"},
-    {389, (char *)"Pacific/Bougainville"},
-    {390, (char *)"Pacific/Chatham"},
-    {391, (char *)"Pacific/Chuuk"},
-    {392, (char *)"Pacific/Easter"},
-    {393, (char *)"Pacific/Efate"},
-    {394, (char *)"Pacific/Enderbury"},
-    {395, (char *)"Pacific/Fakaofo"},
-    {396, (char *)"Pacific/Fiji"},
-    {397, (char *)"Pacific/Funafuti"},
-    {398, (char *)"Pacific/Galapagos"},
-    {399, (char *)"Pacific/Gambier"},
-    {400, (char *)"Pacific/Guadalcanal"},
-    {401, (char *)"Pacific/Guam"},
-    {402, (char *)"Pacific/Honolulu"},
-    {403, (char *)"Pacific/Kiritimati"},
-    {404, (char *)"Pacific/Kosrae"},
-    {405, (char *)"Pacific/Kwajalein"},
-    {406, (char *)"Pacific/Majuro"},
-    {407, (char *)"Pacific/Marquesas"},
-    {408, (char *)"Pacific/Midway"},
-    {409, (char *)"Pacific/Nauru"},
-    {410, (char *)"Pacific/Niue"},
-    {411, (char *)"Pacific/Norfolk"},
-    {412, (char *)"Pacific/Noumea"},
-    {413, (char *)"Pacific/Pago_Pago"},
-    {414, (char *)"Pacific/Palau"},
-    {415, (char *)"Pacific/Pitcairn"},
-    {416, (char *)"Pacific/Pohnpei"},
-    {417, (char *)"Pacific/Port_Moresby"},
-    {418, (char *)"Pacific/Rarotonga"},
-    {419, (char *)"Pacific/Saipan"},
-    {420, (char *)"Pacific/Tahiti"},
-    {421, (char *)"Pacific/Tarawa"},
-    {422, (char *)"Pacific/Tongatapu"},
-    {423, (char *)"Pacific/Wake"},
-    {424, (char *)"Pacific/Wallis"}
-};
-
-ConfigItemMultipleValuesPair timezonesPOSIX[425]{
-    {0, (char *)"GMT0" },
-    {1, (char *)"GMT0" },
-    {2, (char *)"EAT-3" },
-    {3, (char *)"CET-1"},
-    {4, (char *)"EAT-3"},
-    {5, (char *)"GMT0"},
-    {6, (char *)"WAT-1"},
-    {7, (char *)"GMT0"},
-    {8, (char *)"GMT0"},
-    {9, (char *)"CAT-2"},
-    {10, (char *)"WAT-1"},
-    {12, (char *)"CAT-2"},
-    {13, (char *)"EET-2"},
-    {14, (char *)"<+01>-1"},
-    {15, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {16, (char *)"GMT0"},
-    {16, (char *)"GMT0"},
-    {17, (char *)"EAT-3"},
-    {18, (char *)"EAT-3"},
-    {19, (char *)"WAT-1"},
-    {20, (char *)"<+01>-1"},
-    {21, (char *)"GMT0"},
-    {22, (char *)"CAT-2"},
-    {23, (char *)"CAT-2"},
-    {24, (char *)"SAST-2"},
-    {25, (char *)"CAT-2"},
-    {26, (char *)"EAT-3"},
-    {27, (char *)"CAT-2"},
-    {28, (char *)"CAT-2"},
-    {29, (char *)"WAT-1"},
-    {30, (char *)"WAT-1"},
-    {31, (char *)"WAT-1"},
-    {32, (char *)"GMT0"},
-    {33, (char *)"WAT-1"},
-    {34, (char *)"CAT-2"},
-    {35, (char *)"CAT-2"},
-    {36, (char *)"WAT-1"},
-    {37, (char *)"CAT-2"},
-    {38, (char *)"SAST-2"},
-    {39, (char *)"SAST-2"},
-    {40, (char *)"EAT-3"},
-    {41, (char *)"GMT0"},
-    {42, (char *)"EAT-3"},
-    {43, (char *)"WAT-1"},
-    {44, (char *)"WAT-1"},
-    {45, (char *)"GMT0"},
-    {46, (char *)"GMT0"},
-    {47, (char *)"WAT-1"},
-    {48, (char *)"GMT0"},
-    {40, (char *)"EET-2"},
-    {50, (char *)"CET-1"},
-    {51, (char *)"CAT-2"},
-    {52, (char *)"HST10HDT,M3.2.0,M11.1.0"},
-    {53, (char *)"AKST9AKDT,M3.2.0,M11.1.0"},
-    {54, (char *)"AST4"},
-    {55, (char *)"AST4"},
-    {56, (char *)"<-03>3"},
-    {57, (char *)"<-03>3"},
-    {58, (char *)"<-03>3"},
-    {59, (char *)"<-03>3"},
-    {60, (char *)"<-03>3"},
-    {61, (char *)"<-03>3"},
-    {62, (char *)"<-03>3"},
-    {63, (char *)"<-03>3"},
-    {64, (char *)"<-03>3"},
-    {65, (char *)"<-03>3"},
-    {66, (char *)"<-03>3"},
-    {67, (char *)"<-03>3"},
-    {68, (char *)"<-03>3"},
-    {60, (char *)"AST4"},
-    {70, (char *)"<-04>4<-03>,M10.1.0/0,M3.4.0/0"},
-    {71, (char *)"EST5"},
-    {72, (char *)"<-03>3"},
-    {73, (char *)"CST6CDT,M4.1.0,M10.5.0"},
-    {74, (char *)"AST4"},
-    {75, (char *)"<-03>3"},
-    {76, (char *)"CST6"},
-    {77, (char *)"AST4"},
-    {78, (char *)"<-04>4"},
-    {79, (char *)"<-05>5"},
-    {80, (char *)"MST7MDT,M3.2.0,M11.1.0"},
-    {81, (char *)"MST7MDT,M3.2.0,M11.1.0"},
-    {82, (char *)"<-04>4"},
-    {83, (char *)"EST5"},
-    {84, (char *)"<-04>4"},
-    {85, (char *)"<-03>3"},
-    {86, (char *)"EST5"},
-    {87, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {88, (char *)"MST7MDT,M4.1.0,M10.5.0"},
-    {89, (char *)"CST6"},
-    {90, (char *)"MST7"},
-    {91, (char *)"<-04>4"},
-    {92, (char *)"AST4"},
-    {93, (char *)"GMT0"},
-    {94, (char *)"MST7"},
-    {95, (char *)"MST7"},
-    {96, (char *)"MST7MDT,M3.2.0,M11.1.0"},
-    {97, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {98, (char *)"AST4"},
-    {99, (char *)"MST7MDT,M3.2.0,M11.1.0"},
-    {100, (char *)"<-05>5"},
-    {101, (char *)"CST6"},
-    {102, (char *)"<-03>3"},
-    {103, (char *)"MST7"},
-    {104, (char *)"AST4ADT,M3.2.0,M11.1.0"},
-    {105, (char *)"<-03>3<-02>,M3.5.0/-2,M10.5.0/-1"},
-    {106, (char *)"AST4ADT,M3.2.0,M11.1.0"},
-    {107, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {108, (char *)"AST4"},
-    {109, (char *)"AST4"},
-    {110, (char *)"CST6"},
-    {111, (char *)"<-05>5"},
-    {112, (char *)"<-04>4"},
-    {113, (char *)"AST4ADT,M3.2.0,M11.1.0"},
-    {114, (char *)"CST5CDT,M3.2.0/0,M11.1.0/1"},
-    {115, (char *)"MST7"},
-    {116, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {117, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {118, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {119, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {120, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {121, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {122, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {123, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {124, (char *)"MST7MDT,M3.2.0,M11.1.0"},
-    {125, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {126, (char *)"EST5"},
-    {127, (char *)"AKST9AKDT,M3.2.0,M11.1.0"},
-    {128, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {129, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {130, (char *)"AST4"},
-    {131, (char *)"<-04>4"},
-    {132, (char *)"<-05>5"},
-    {133, (char *)"PST8PDT,M3.2.0,M11.1.0"},
-    {134, (char *)"AST4"},
-    {135, (char *)"<-03>3"},
-    {136, (char *)"CST6"},
-    {137, (char *)"<-04>4"},
-    {138, (char *)"AST4"},
-    {139, (char *)"AST4"},
-    {140, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {141, (char *)"MST7MDT,M4.1.0,M10.5.0"},
-    {142, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {143, (char *)"CST6CDT,M4.1.0,M10.5.0"},
-    {144, (char *)"AKST9AKDT,M3.2.0,M11.1.0"},
-    {145, (char *)"CST6CDT,M4.1.0,M10.5.0"},
-    {146, (char *)"<-03>3<-02>,M3.2.0,M11.1.0"},
-    {147, (char *)"AST4ADT,M3.2.0,M11.1.0"},
-    {148, (char *)"CST6CDT,M4.1.0,M10.5.0"},
-    {149, (char *)"<-03>3"},
-    {150, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {151, (char *)"AST4"},
-    {152, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {153, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {154, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {155, (char *)"AKST9AKDT,M3.2.0,M11.1.0"},
-    {156, (char *) "<-02>2"},
-    {157, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {158, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {159, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {160, (char *)"MST7MDT,M3.2.0,M11.1.0"},
-    {161, (char *)"EST5"},
-    {162, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {163, (char *)"<-03>3"},
-    {164, (char *)"MST7"},
-    {165, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {166, (char *)"AST4"},
-    {167, (char *)"<-04>4"},
-    {168, (char *)"AST4"},
-    {169, (char *)"<-03>3"},
-    {170, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {171, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {172, (char *)"<-03>3"},
-    {173, (char *)"CST6"},
-    {174, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {175, (char *)"<-05>5"},
-    {176, (char *)"<-03>3"},
-    {177, (char *)"<-04>4<-03>,M9.1.6/24,M4.1.6/24"},
-    {178, (char *)"AST4"},
-    {179, (char *)"<-03>3"},
-    {180, (char *)"<-01>1<+00>,M3.5.0/0,M10.5.0/1"},
-    {181, (char *)"AKST9AKDT,M3.2.0,M11.1.0"},
-    {182, (char *)"AST4"},
-    {183, (char *)"NST3:30NDT,M3.2.0,M11.1.0"},
-    {184, (char *)"AST4"},
-    {185, (char *)"AST4"},
-    {186, (char *)"AST4"},
-    {187, (char *)"AST4"},
-    {188, (char *)"CST6"},
-    {189, (char *)"CST6"},
-    {190, (char *)"AST4ADT,M3.2.0,M11.1.0"},
-    {191, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {192, (char *)"PST8PDT,M3.2.0,M11.1.0"},
-    {193, (char *)"EST5EDT,M3.2.0,M11.1.0"},
-    {194, (char *)"AST4"},
-    {195, (char *)"PST8PDT,M3.2.0,M11.1.0"},
-    {196, (char *)"MST7"},
-    {197, (char *)"CST6CDT,M3.2.0,M11.1.0"},
-    {198, (char *)"AKST9AKDT,M3.2.0,M11.1.0"},
-    {199, (char *)"MST7MDT,M3.2.0,M11.1.0"},
-    {200, (char *)"<+11>-11"},
-    {201, (char *)"<+07>-7"},
-    {202, (char *)"<+10>-10"},
-    {203, (char *)"AEST-10AEDT,M10.1.0,M4.1.0/3"},
-    {204, (char *)"<+05>-5"},
-    {205, (char *)"NZST-12NZDT,M9.5.0,M4.1.0/3"},
-    {206, (char *)"<-03>3"},
-    {207, (char *)"<-03>3"},
-    {208, (char *)"<+03>-3"},
-    {209, (char *)"<+00>0<+02>-2,M3.5.0/1,M10.5.0/3"},
-    {210, (char *)"<+06>-6"},
-    {211, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {212, (char *)"<+03>-3"},
-    {213, (char *)"<+06>-6"},
-    {214, (char *)"EET-2EEST,M2.5.4/24,M10.5.5/1"},
-    {215, (char *)"<+12>-12"},
-    {216, (char *)"<+05>-5"},
-    {217, (char *)"<+05>-5"},
-    {218, (char *)"<+05>-5"},
-    {219, (char *)"<+05>-5"},
-    {220, (char *)"<+03>-3"},
-    {221, (char *)"<+03>-3"},
-    {222, (char *)"<+04>-4"},
-    {223, (char *)"<+07>-7"},
-    {224, (char *)"<+07>-7"},
-    {225, (char *)"EET-2EEST,M3.5.0/0,M10.5.0/0"},
-    {226, (char *)"<+06>-6"},
-    {227, (char *)"<+08>-8"},
-    {228, (char *)"<+09>-9"},
-    {229, (char *)"<+08>-8"},
-    {230, (char *)"<+0530>-5:30"},
-    {231, (char *)"EET-2EEST,M3.5.5/0,M10.5.5/0"},
-    {232, (char *)"<+06>-6"},
-    {233, (char *)"<+09>-9"},
-    {234, (char *)"<+04>-4"},
-    {235, (char *)"<+05>-5"},
-    {236, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {237, (char *)"EET-2EEST,M3.4.4/48,M10.5.5/1"},
-    {238, (char *)"EET-2EEST,M3.4.4/48,M10.5.5/1"},
-    {239, (char *)"<+07>-7"},
-    {240, (char *)"HKT-8"},
-    {241, (char *)"<+07>-7"},
-    {242, (char *)"<+08>-8"},
-    {243, (char *)"WIB-7"},
-    {244, (char *)"WIT-9"},
-    {245, (char *)"IST-2IDT,M3.4.4/26,M10.5.0"},
-    {246, (char *)"<+0430>-4:30"},
-    {247, (char *)"<+12>-12"},
-    {248, (char *)"PKT-5"},
-    {249, (char *)"<+0545>-5:45"},
-    {250, (char *)"<+09>-9"},
-    {251, (char *)"IST-5:30"},
-    {252, (char *)"<+07>-7"},
-    {253, (char *)"<+08>-8"},
-    {254, (char *)"<+08>-8"},
-    {255, (char *)"<+03>-3"},
-    {256, (char *)"CST-8"},
-    {257, (char *)"<+11>-11"},
-    {258, (char *)"WITA-8"},
-    {259, (char *)"PST-8"},
-    {260, (char *)"<+04>-4"},
-    {261, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {262, (char *)"<+07>-7"},
-    {263, (char *)"<+07>-7"},
-    {264, (char *)"<+06>-6"},
-    {265, (char *)"<+05>-5"},
-    {266, (char *)"<+07>-7"},
-    {267, (char *)"WIB-7"},
-    {268, (char *)"KST-9"},
-    {269, (char *)"<+03>-3"},
-    {270, (char *)"<+05>-5"},
-    {271, (char *)"<+03>-3"},
-    {272, (char *)"<+11>-11"},
-    {273, (char *)"<+05>-5"},
-    {274, (char *)"KST-9"},
-    {275, (char *)"CST-8"},
-    {276, (char *)"<+08>-8"},
-    {277, (char *)"<+11>-11"},
-    {278, (char *)"CST-8"},
-    {279, (char *)"<+05>-5"},
-    {280, (char *)"<+04>-4"},
-    {281, (char *)"<+0330>-3:30<+0430>,J79/24,J263/24"},
-    {282, (char *)"<+06>-6"},
-    {283, (char *)"JST-9"},
-    {284, (char *)"<+07>-7"},
-    {285, (char *)"<+08>-8"},
-    {286, (char *)"<+06>-6"},
-    {287, (char *)"<+10>-10"},
-    {288, (char *)"<+07>-7"},
-    {289, (char *)"<+10>-10"},
-    {290, (char *)"<+09>-9"},
-    {291, (char *)"<+0630>-6:30"},
-    {292, (char *)"<+05>-5"},
-    {293, (char *)"<+04>-4"},
-    {294, (char *)"<-01>1<+00>,M3.5.0/0,M10.5.0/1"},
-    {295, (char *)"AST4ADT,M3.2.0,M11.1.0"},
-    {296, (char *)"WET0WEST,M3.5.0/1,M10.5.0"},
-    {297, (char *)"<-01>1"},
-    {298, (char *)"WET0WEST,M3.5.0/1,M10.5.0"},
-    {299, (char *)"WET0WEST,M3.5.0/1,M10.5.0"},
-    {300, (char *)"GMT0"},
-    {301, (char *)"<-02>2"},
-    {302, (char *)"<-03>3"},
-    {303, (char *)"GMT0"},
-    {304, (char *)"ACST-9:30ACDT,M10.1.0,M4.1.0/3"},
-    {305, (char *)"AEST-10"},
-    {306, (char *)"ACST-9:30ACDT,M10.1.0,M4.1.0/3"},
-    {307, (char *)"AEST-10AEDT,M10.1.0,M4.1.0/3"},
-    {308, (char *)"ACST-9:30"},
-    {309, (char *)"<+0845>-8:45"},
-    {310, (char *)"AEST-10AEDT,M10.1.0,M4.1.0/3"},
-    {311, (char *)"AEST-10"},
-    {312, (char *)"<+1030>-10:30<+11>-11,M10.1.0,M4.1.0"},
-    {313, (char *)"AEST-10AEDT,M10.1.0,M4.1.0/3"},
-    {314, (char *)"AWST-8"},
-    {315, (char *)"AEST-10AEDT,M10.1.0,M4.1.0/3"},
-    {316, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {317, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {318, (char *)"<+04>-4"},
-    {319, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {320, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {321, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {322, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {323, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {324, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {325, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {326, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {327, (char *)"EET-2EEST,M3.5.0,M10.5.0/3"},
-    {328, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {329, (char *)"IST-1GMT0,M10.5.0,M3.5.0/1"},
-    {330, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {331, (char *)"GMT0BST,M3.5.0/1,M10.5.0"},
-    {332, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {333, (char *)"GMT0BST,M3.5.0/1,M10.5.0"},
-    {334, (char *) "<+03>-3"},
-    {335, (char *)"GMT0BST,M3.5.0/1,M10.5.0"},
-    {336, (char *)"EET-2"},
-    {337, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {338, (char *)"<+03>-3"},
-    {339, (char *)"WET0WEST,M3.5.0/1,M10.5.0"},
-    {340, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {341, (char *)"GMT0BST,M3.5.0/1,M10.5.0"},
-    {342, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {343, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {344, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {345, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {346, (char *)"<+03>-3"},
-    {347, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {348, (char *)"MSK-3"},
-    {349, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {350, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {351, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {352, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {353, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {354, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {355, (char *)"<+04>-4"},
-    {356, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {357, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {358, (char *)"<+04>-4"},
-    {359, (char *)"MSK-3"},
-    {360, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {361, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {362, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {363, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {364, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {365, (char *)"<+04>-4"},
-    {366, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {367, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {368, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {369, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {370, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {371, (char *)"<+03>-3"},
-    {372, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {373, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {374, (char *)"EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {375, (char *)"CET-1CEST,M3.5.0,M10.5.0/3"},
-    {376, (char *)"EAT-3"},
-    {377, (char *)"<+06>-6"},
-    {378, (char *)"<+07>-7"},
-    {379, (char *)"<+0630>-6:30"},
-    {380, (char *)"EAT-3"},
-    {381, (char *)"<+05>-5"},
-    {382, (char *)"<+04>-4"},
-    {383, (char *)"<+05>-5"},
-    {384, (char *)"<+04>-4"},
-    {385, (char *)"EAT-3"},
-    {386, (char *)"<+04>-4"},
-    {387, (char *)"<+13>-13"},
-    {388, (char *)"NZST-12NZDT,M9.5.0,M4.1.0/3"},
-    {389, (char *)"<+11>-11"},
-    {390, (char *)"<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45"},
-    {391, (char *)"<+10>-10"},
-    {392, (char *)"<-06>6<-05>,M9.1.6/22,M4.1.6/22"},
-    {393, (char *)"<+11>-11"},
-    {394, (char *)"<+13>-13"},
-    {395, (char *)"<+13>-13"},
-    {396, (char *)"<+12>-12<+13>,M11.2.0,M1.2.3/99"},
-    {397, (char *)"<+12>-12"},
-    {398, (char *)"<-06>6"},
-    {399, (char *)"<-09>9"},
-    {400, (char *)"<+11>-11"},
-    {401, (char *)"ChST-10"},
-    {402, (char *)"HST10"},
-    {403, (char *)"<+14>-14"},
-    {404, (char *)"<+11>-11"},
-    {405, (char *)"<+12>-12"},
-    {406, (char *)"<+12>-12"},
-    {407, (char *)"<-0930>9:30"},
-    {408, (char *)"SST11"},
-    {409, (char *)"<+12>-12"},
-    {410, (char *)"<-11>11"},
-    {411, (char *)"<+11>-11<+12>,M10.1.0,M4.1.0/3"},
-    {412, (char *)"<+11>-11"},
-    {413, (char *)"SST11"},
-    {414, (char *)"<+09>-9"},
-    {415, (char *)"<-08>8"},
-    {416, (char *)"<+11>-11"},
-    {417, (char *)"<+10>-10"},
-    {418, (char *)"<-10>10"},
-    {419, (char *)"ChST-10"},
-    {420, (char *)"<-10>10"},
-    {421, (char *)"<+12>-12"},
-    {422, (char *)"<+13>-13"},
-    {423, (char *)"<+12>-12"},
-    {424, (char *)"<+12>-12"}
-};
@@ -0,0 +1,140 @@
+#define TZDB_IMPLEMENTATION
+#include "tzdb.h"
+#include <string.h>
+
+const char *tzdbName(uint32_t zone)
+{
+    return tzdbNames + tzdbZones[zone].name;
+}
+
+const TzRule *tzdbRule(uint32_t zone)
+{
+    return tzdbRules + tzdbZones[zone].rule;
+}
+
+// Returns the position of name in tzdbSorted or where it would have to be inserted
+static uint32_t findPosition(const char *name)
+{
+    uint32_t low = 0;
+    uint32_t high = TZDB_ZONE_COUNT;
+    while(low < high)
+    {
+        uint32_t mid = (low + high) / 2;
+        if(strcmp(tzdbName(tzdbSorted[mid]), name) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+// Returns the zone with the given name or -1
+int32_t tzdbFind(const char *name)
+{
+    uint32_t position = findPosition(name);
+    if(position < TZDB_ZONE_COUNT && strcmp(tzdbName(tzdbSorted[position]), name) == 0)
+        return tzdbSorted[position];
+
+    return -1;
+}
+
+uint32_t tzdbSortedZone(uint32_t position)
+{
+    return tzdbSorted[position];
+}
+
+uint32_t tzdbSortedPosition(uint32_t zone)
+{
+    return findPosition(tzdbName(zone));
+}
+
+uint32_t tzdbRegionOf(uint32_t position)
+{
+    uint32_t low = 0;
+    uint32_t high = TZDB_REGION_COUNT;
+    while(high - low > 1)
+    {
+        uint32_t mid = (low + high) / 2;
+        if(tzdbRegions[mid] <= position)
+            low = mid;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+uint32_t tzdbRegionStart(uint32_t region)
+{
+    return tzdbRegions[region];
+}
+
+// Search keys only consist of lowercase letters and digits, everything else gets skipped. Returns the
+// next character of the key and advances *str past it or returns 0 at the end.
+static char searchChar(const char **str)
+{
+    char c;
+    while((c = **str) != '\0')
+    {
+        ++*str;
+        if(c >= 'A' && c <= 'Z')
+            return c + ('a' - 'A');
+        if((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))
+            return c;
+    }
+
+    return '\0';
+}
+
+// Compares the search key of name with prefix, equal if the key starts with it
+static int compareKey(const char *name, const char *prefix)
+{
+    char p;
+    while((p = searchChar(&prefix)) != '\0')
+    {
+        char n = searchChar(&name);
+        if(n != p)
+            return (unsigned char)n - (unsigned char)p;
+    }
+
+    return 0;
+}
+
+static const char *cityName(uint32_t zone)
+{
+    const char *name = tzdbName(zone);
+    const char *city = strrchr(name, '/');
+    return city == NULL ? name : city + 1;
+}
+
+static int32_t searchIndex(const uint16_t *index, bool city, const char *prefix)
+{
+    uint32_t low = 0;
+    uint32_t high = TZDB_ZONE_COUNT;
+    while(low < high)
+    {
+        uint32_t mid = (low + high) / 2;
+        if(compareKey(city ? cityName(index[mid]) : tzdbName(index[mid]), prefix) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    if(low < TZDB_ZONE_COUNT && compareKey(city ? cityName(index[low]) : tzdbName(index[low]), prefix) == 0)
+        return index[low];
+
+    return -1;
+}
+
+// Returns the first zone whose city or, failing that, whose whole name starts with prefix or -1. Case,
+// slashes, underscores and dots are ignored, so "newy" and "america.new" both find America/New_York.
+int32_t tzdbSearch(const char *prefix)
+{
+    const char *p = prefix;
+    if(searchChar(&p) == '\0')
+        return -1;
+
+    int32_t zone = searchIndex(tzdbByCity, true, prefix);
+    return zone == -1 ? searchIndex(tzdbByName, false, prefix) : zone;
+}
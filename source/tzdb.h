@@ -0,0 +1,32 @@
+#pragma once
+#include "tzrule.h"
+#include <wut.h>
+
+// The timezone database compiled into the plugin by tools/tzdbgen.py. Zones are numbered in the order of
+// tools/zones.txt, which is also what the settings store.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct TzdbZone {
+    uint16_t name; // Offset into the name pool
+    uint16_t rule; // Index of the pre-parsed rule
+} TzdbZone;
+
+const char *tzdbName(uint32_t zone);
+const TzRule *tzdbRule(uint32_t zone);
+int32_t tzdbFind(const char *name);
+
+// The picker walks the zones sorted by name, so zones of the same region are next to each other
+uint32_t tzdbSortedZone(uint32_t position);
+uint32_t tzdbSortedPosition(uint32_t zone);
+uint32_t tzdbRegionOf(uint32_t position);
+uint32_t tzdbRegionStart(uint32_t region);
+int32_t tzdbSearch(const char *prefix);
+
+#ifdef __cplusplus
+}
+#endif
+
+#include "tzdb_data.h"
@@ -0,0 +1,1034 @@
+// Generated by tools/tzdbgen.py from tzdata 2025b, do not edit.
+#pragma once
+
+#define TZDB_VERSION "2025b"
+#define TZDB_ZONE_COUNT 425
+#define TZDB_RULE_COUNT 64
+#define TZDB_REGION_COUNT 10
+#define TZDB_NAME_MAX 31 // Longest zone name with its \0
+
+#ifdef TZDB_IMPLEMENTATION
+
+// All zone names, separated by \0
+static const char tzdbNames[7019] =
+    "Africa/Abidjan\0"
+    "Africa/Accra\0"
+    "Africa/Addis_Ababa\0"
+    "Africa/Algiers\0"
+    "Africa/Asmara\0"
+    "Africa/Bamako\0"
+    "Africa/Bangui\0"
+    "Africa/Banjul\0"
+    "Africa/Bissau\0"
+    "Africa/Blantyre\0"
+    "Africa/Brazzaville\0"
+    "Africa/Bujumbura\0"
+    "Africa/Cairo\0"
+    "Africa/Casablanca\0"
+    "Africa/Ceuta\0"
+    "Africa/Conakry\0"
+    "Africa/Dakar\0"
+    "Africa/Dar_es_Salaam\0"
+    "Africa/Djibouti\0"
+    "Africa/Douala\0"
+    "Africa/El_Aaiun\0"
+    "Africa/Freetown\0"
+    "Africa/Gaborone\0"
+    "Africa/Harare\0"
+    "Africa/Johannesburg\0"
+    "Africa/Juba\0"
+    "Africa/Kampala\0"
+    "Africa/Khartoum\0"
+    "Africa/Kigali\0"
+    "Africa/Kinshasa\0"
+    "Africa/Lagos\0"
+    "Africa/Libreville\0"
+    "Africa/Lome\0"
+    "Africa/Luanda\0"
+    "Africa/Lubumbashi\0"
+    "Africa/Lusaka\0"
+    "Africa/Malabo\0"
+    "Africa/Maputo\0"
+    "Africa/Maseru\0"
+    "Africa/Mbabane\0"
+    "Africa/Mogadishu\0"
+    "Africa/Monrovia\0"
+    "Africa/Nairobi\0"
+    "Africa/Ndjamena\0"
+    "Africa/Niamey\0"
+    "Africa/Nouakchott\0"
+    "Africa/Ouagadougou\0"
+    "Africa/Porto-Novo\0"
+    "Africa/Sao_Tome\0"
+    "Africa/Tripoli\0"
+    "Africa/Tunis\0"
+    "Africa/Windhoek\0"
+    "America/Adak\0"
+    "America/Anchorage\0"
+    "America/Anguilla\0"
+    "America/Antigua\0"
+    "America/Araguaina\0"
+    "America/Argentina/Buenos_Aires\0"
+    "America/Argentina/Catamarca\0"
+    "America/Argentina/Cordoba\0"
+    "America/Argentina/Jujuy\0"
+    "America/Argentina/La_Rioja\0"
+    "America/Argentina/Mendoza\0"
+    "America/Argentina/Rio_Gallegos\0"
+    "America/Argentina/Salta\0"
+    "America/Argentina/San_Juan\0"
+    "America/Argentina/San_Luis\0"
+    "America/Argentina/Tucuman\0"
+    "America/Argentina/Ushuaia\0"
+    "America/Aruba\0"
+    "America/Asuncion\0"
+    "America/Atikokan\0"
+    "America/Bahia\0"
+    "America/Bahia_Banderas\0"
+    "America/Barbados\0"
+    "America/Belem\0"
+    "America/Belize\0"
+    "America/Blanc-Sablon\0"
+    "America/Boa_Vista\0"
+    "America/Bogota\0"
+    "America/Boise\0"
+    "America/Cambridge_Bay\0"
+    "America/Campo_Grande\0"
+    "America/Cancun\0"
+    "America/Caracas\0"
+    "America/Cayenne\0"
+    "America/Cayman\0"
+    "America/Chicago\0"
+    "America/Chihuahua\0"
+    "America/Costa_Rica\0"
+    "America/Creston\0"
+    "America/Cuiaba\0"
+    "America/Curacao\0"
+    "America/Danmarkshavn\0"
+    "America/Dawson\0"
+    "America/Dawson_Creek\0"
+    "America/Denver\0"
+    "America/Detroit\0"
+    "America/Dominica\0"
+    "America/Edmonton\0"
+    "America/Eirunepe\0"
+    "America/El_Salvador\0"
+    "America/Fortaleza\0"
+    "America/Fort_Nelson\0"
+    "America/Glace_Bay\0"
+    "America/Godthab\0"
+    "America/Goose_Bay\0"
+    "America/Grand_Turk\0"
+    "America/Grenada\0"
+    "America/Guadeloupe\0"
+    "America/Guatemala\0"
+    "America/Guayaquil\0"
+    "America/Guyana\0"
+    "America/Halifax\0"
+    "America/Havana\0"
+    "America/Hermosillo\0"
+    "America/Indiana/Indianapolis\0"
+    "America/Indiana/Knox\0"
+    "America/Indiana/Marengo\0"
+    "America/Indiana/Petersburg\0"
+    "America/Indiana/Tell_City\0"
+    "America/Indiana/Vevay\0"
+    "America/Indiana/Vincennes\0"
+    "America/Indiana/Winamac\0"
+    "America/Inuvik\0"
+    "America/Iqaluit\0"
+    "America/Jamaica\0"
+    "America/Juneau\0"
+    "America/Kentucky/Louisville\0"
+    "America/Kentucky/Monticello\0"
+    "America/Kralendijk\0"
+    "America/La_Paz\0"
+    "America/Lima\0"
+    "America/Los_Angeles\0"
+    "America/Lower_Princes\0"
+    "America/Maceio\0"
+    "America/Managua\0"
+    "America/Manaus\0"
+    "America/Marigot\0"
+    "America/Martinique\0"
+    "America/Matamoros\0"
+    "America/Mazatlan\0"
+    "America/Menominee\0"
+    "America/Merida\0"
+    "America/Metlakatla\0"
+    "America/Mexico_City\0"
+    "America/Miquelon\0"
+    "America/Moncton\0"
+    "America/Monterrey\0"
+    "America/Montevideo\0"
+    "America/Montreal\0"
+    "America/Montserrat\0"
+    "America/Nassau\0"
+    "America/New_York\0"
+    "America/Nipigon\0"
+    "America/Nome\0"
+    "America/Noronha\0"
+    "America/North_Dakota/Beulah\0"
+    "America/North_Dakota/Center\0"
+    "America/North_Dakota/New_Salem\0"
+    "America/Ojinaga\0"
+    "America/Panama\0"
+    "America/Pangnirtung\0"
+    "America/Paramaribo\0"
+    "America/Phoenix\0"
+    "America/Port-au-Prince\0"
+    "America/Port_of_Spain\0"
+    "America/Porto_Velho\0"
+    "America/Puerto_Rico\0"
+    "America/Punta_Arenas\0"
+    "America/Rainy_River\0"
+    "America/Rankin_Inlet\0"
+    "America/Recife\0"
+    "America/Regina\0"
+    "America/Resolute\0"
+    "America/Rio_Branco\0"
+    "America/Santarem\0"
+    "America/Santiago\0"
+    "America/Santo_Domingo\0"
+    "America/Sao_Paulo\0"
+    "America/Scoresbysund\0"
+    "America/Sitka\0"
+    "America/St_Barthelemy\0"
+    "America/St_Johns\0"
+    "America/St_Kitts\0"
+    "America/St_Lucia\0"
+    "America/St_Thomas\0"
+    "America/St_Vincent\0"
+    "America/Swift_Current\0"
+    "America/Tegucigalpa\0"
+    "America/Thule\0"
+    "America/Thunder_Bay\0"
+    "America/Tijuana\0"
+    "America/Toronto\0"
+    "America/Tortola\0"
+    "America/Vancouver\0"
+    "America/Whitehorse\0"
+    "America/Winnipeg\0"
+    "America/Yakutat\0"
+    "America/Yellowknife\0"
+    "Antarctica/Casey\0"
+    "Antarctica/Davis\0"
+    "Antarctica/DumontDUrville\0"
+    "Antarctica/Macquarie\0"
+    "Antarctica/Mawson\0"
+    "Antarctica/McMurdo\0"
+    "Antarctica/Palmer\0"
+    "Antarctica/Rothera\0"
+    "Antarctica/Syowa\0"
+    "Antarctica/Troll\0"
+    "Antarctica/Vostok\0"
+    "Arctic/Longyearbyen\0"
+    "Asia/Aden\0"
+    "Asia/Almaty\0"
+    "Asia/Amman\0"
+    "Asia/Anadyr\0"
+    "Asia/Aqtau\0"
+    "Asia/Aqtobe\0"
+    "Asia/Ashgabat\0"
+    "Asia/Atyrau\0"
+    "Asia/Baghdad\0"
+    "Asia/Bahrain\0"
+    "Asia/Baku\0"
+    "Asia/Bangkok\0"
+    "Asia/Barnaul\0"
+    "Asia/Beirut\0"
+    "Asia/Bishkek\0"
+    "Asia/Brunei\0"
+    "Asia/Chita\0"
+    "Asia/Choibalsan\0"
+    "Asia/Colombo\0"
+    "Asia/Damascus\0"
+    "Asia/Dhaka\0"
+    "Asia/Dili\0"
+    "Asia/Dubai\0"
+    "Asia/Dushanbe\0"
+    "Asia/Famagusta\0"
+    "Asia/Gaza\0"
+    "Asia/Hebron\0"
+    "Asia/Ho_Chi_Minh\0"
+    "Asia/Hong_Kong\0"
+    "Asia/Hovd\0"
+    "Asia/Irkutsk\0"
+    "Asia/Jakarta\0"
+    "Asia/Jayapura\0"
+    "Asia/Jerusalem\0"
+    "Asia/Kabul\0"
+    "Asia/Kamchatka\0"
+    "Asia/Karachi\0"
+    "Asia/Kathmandu\0"
+    "Asia/Khandyga\0"
+    "Asia/Kolkata\0"
+    "Asia/Krasnoyarsk\0"
+    "Asia/Kuala_Lumpur\0"
+    "Asia/Kuching\0"
+    "Asia/Kuwait\0"
+    "Asia/Macau\0"
+    "Asia/Magadan\0"
+    "Asia/Makassar\0"
+    "Asia/Manila\0"
+    "Asia/Muscat\0"
+    "Asia/Nicosia\0"
+    "Asia/Novokuznetsk\0"
+    "Asia/Novosibirsk\0"
+    "Asia/Omsk\0"
+    "Asia/Oral\0"
+    "Asia/Phnom_Penh\0"
+    "Asia/Pontianak\0"
+    "Asia/Pyongyang\0"
+    "Asia/Qatar\0"
+    "Asia/Qyzylorda\0"
+    "Asia/Riyadh\0"
+    "Asia/Sakhalin\0"
+    "Asia/Samarkand\0"
+    "Asia/Seoul\0"
+    "Asia/Shanghai\0"
+    "Asia/Singapore\0"
+    "Asia/Srednekolymsk\0"
+    "Asia/Taipei\0"
+    "Asia/Tashkent\0"
+    "Asia/Tbilisi\0"
+    "Asia/Tehran\0"
+    "Asia/Thimphu\0"
+    "Asia/Tokyo\0"
+    "Asia/Tomsk\0"
+    "Asia/Ulaanbaatar\0"
+    "Asia/Urumqi\0"
+    "Asia/Ust-Nera\0"
+    "Asia/Vientiane\0"
+    "Asia/Vladivostok\0"
+    "Asia/Yakutsk\0"
+    "Asia/Yangon\0"
+    "Asia/Yekaterinburg\0"
+    "Asia/Yerevan\0"
+    "Atlantic/Azores\0"
+    "Atlantic/Bermuda\0"
+    "Atlantic/Canary\0"
+    "Atlantic/Cape_Verde\0"
+    "Atlantic/Faroe\0"
+    "Atlantic/Madeira\0"
+    "Atlantic/Reykjavik\0"
+    "Atlantic/South_Georgia\0"
+    "Atlantic/Stanley\0"
+    "Atlantic/St_Helena\0"
+    "Australia/Adelaide\0"
+    "Australia/Brisbane\0"
+    "Australia/Broken_Hill\0"
+    "Australia/Currie\0"
+    "Australia/Darwin\0"
+    "Australia/Eucla\0"
+    "Australia/Hobart\0"
+    "Australia/Lindeman\0"
+    "Australia/Lord_Howe\0"
+    "Australia/Melbourne\0"
+    "Australia/Perth\0"
+    "Australia/Sydney\0"
+    "Europe/Amsterdam\0"
+    "Europe/Andorra\0"
+    "Europe/Astrakhan\0"
+    "Europe/Athens\0"
+    "Europe/Belgrade\0"
+    "Europe/Berlin\0"
+    "Europe/Bratislava\0"
+    "Europe/Brussels\0"
+    "Europe/Bucharest\0"
+    "Europe/Budapest\0"
+    "Europe/Busingen\0"
+    "Europe/Chisinau\0"
+    "Europe/Copenhagen\0"
+    "Europe/Dublin\0"
+    "Europe/Gibraltar\0"
+    "Europe/Guernsey\0"
+    "Europe/Helsinki\0"
+    "Europe/Isle_of_Man\0"
+    "Europe/Istanbul\0"
+    "Europe/Jersey\0"
+    "Europe/Kaliningrad\0"
+    "Europe/Kiev\0"
+    "Europe/Kirov\0"
+    "Europe/Lisbon\0"
+    "Europe/Ljubljana\0"
+    "Europe/London\0"
+    "Europe/Luxembourg\0"
+    "Europe/Madrid\0"
+    "Europe/Malta\0"
+    "Europe/Mariehamn\0"
+    "Europe/Minsk\0"
+    "Europe/Monaco\0"
+    "Europe/Moscow\0"
+    "Europe/Oslo\0"
+    "Europe/Paris\0"
+    "Europe/Podgorica\0"
+    "Europe/Prague\0"
+    "Europe/Riga\0"
+    "Europe/Rome\0"
+    "Europe/Samara\0"
+    "Europe/San_Marino\0"
+    "Europe/Sarajevo\0"
+    "Europe/Saratov\0"
+    "Europe/Simferopol\0"
+    "Europe/Skopje\0"
+    "Europe/Sofia\0"
+    "Europe/Stockholm\0"
+    "Europe/Tallinn\0"
+    "Europe/Tirane\0"
+    "Europe/Ulyanovsk\0"
+    "Europe/Uzhgorod\0"
+    "Europe/Vaduz\0"
+    "Europe/Vatican\0"
+    "Europe/Vienna\0"
+    "Europe/Vilnius\0"
+    "Europe/Volgograd\0"
+    "Europe/Warsaw\0"
+    "Europe/Zagreb\0"
+    "Europe/Zaporozhye\0"
+    "Europe/Zurich\0"
+    "Indian/Antananarivo\0"
+    "Indian/Chagos\0"
+    "Indian/Christmas\0"
+    "Indian/Cocos\0"
+    "Indian/Comoro\0"
+    "Indian/Kerguelen\0"
+    "Indian/Mahe\0"
+    "Indian/Maldives\0"
+    "Indian/Mauritius\0"
+    "Indian/Mayotte\0"
+    "Indian/Reunion\0"
+    "Pacific/Apia\0"
+    "Pacific/Auckland\0"
+    "Pacific/Bougainville\0"
+    "Pacific/Chatham\0"
+    "Pacific/Chuuk\0"
+    "Pacific/Easter\0"
+    "Pacific/Efate\0"
+    "Pacific/Enderbury\0"
+    "Pacific/Fakaofo\0"
+    "Pacific/Fiji\0"
+    "Pacific/Funafuti\0"
+    "Pacific/Galapagos\0"
+    "Pacific/Gambier\0"
+    "Pacific/Guadalcanal\0"
+    "Pacific/Guam\0"
+    "Pacific/Honolulu\0"
+    "Pacific/Kiritimati\0"
+    "Pacific/Kosrae\0"
+    "Pacific/Kwajalein\0"
+    "Pacific/Majuro\0"
+    "Pacific/Marquesas\0"
+    "Pacific/Midway\0"
+    "Pacific/Nauru\0"
+    "Pacific/Niue\0"
+    "Pacific/Norfolk\0"
+    "Pacific/Noumea\0"
+    "Pacific/Pago_Pago\0"
+    "Pacific/Palau\0"
+    "Pacific/Pitcairn\0"
+    "Pacific/Pohnpei\0"
+    "Pacific/Port_Moresby\0"
+    "Pacific/Rarotonga\0"
+    "Pacific/Saipan\0"
+    "Pacific/Tahiti\0"
+    "Pacific/Tarawa\0"
+    "Pacific/Tongatapu\0"
+    "Pacific/Wake\0"
+    "Pacific/Wallis\0";
+
+// Offset of the name in tzdbNames and index into tzdbRules, in the order of tools/zones.txt
+static const TzdbZone tzdbZones[TZDB_ZONE_COUNT] = {
+    { 0, 0 }, // Africa/Abidjan
+    { 15, 0 }, // Africa/Accra
+    { 28, 1 }, // Africa/Addis_Ababa
+    { 47, 2 }, // Africa/Algiers
+    { 62, 1 }, // Africa/Asmara
+    { 76, 0 }, // Africa/Bamako
+    { 90, 2 }, // Africa/Bangui
+    { 104, 0 }, // Africa/Banjul
+    { 118, 0 }, // Africa/Bissau
+    { 132, 3 }, // Africa/Blantyre
+    { 148, 2 }, // Africa/Brazzaville
+    { 167, 3 }, // Africa/Bujumbura
+    { 184, 4 }, // Africa/Cairo
+    { 197, 2 }, // Africa/Casablanca
+    { 215, 5 }, // Africa/Ceuta
+    { 228, 0 }, // Africa/Conakry
+    { 243, 0 }, // Africa/Dakar
+    { 256, 1 }, // Africa/Dar_es_Salaam
+    { 277, 1 }, // Africa/Djibouti
+    { 293, 2 }, // Africa/Douala
+    { 307, 2 }, // Africa/El_Aaiun
+    { 323, 0 }, // Africa/Freetown
+    { 339, 3 }, // Africa/Gaborone
+    { 355, 3 }, // Africa/Harare
+    { 369, 3 }, // Africa/Johannesburg
+    { 389, 3 }, // Africa/Juba
+    { 401, 1 }, // Africa/Kampala
+    { 416, 3 }, // Africa/Khartoum
+    { 432, 3 }, // Africa/Kigali
+    { 446, 2 }, // Africa/Kinshasa
+    { 462, 2 }, // Africa/Lagos
+    { 475, 2 }, // Africa/Libreville
+    { 493, 0 }, // Africa/Lome
+    { 505, 2 }, // Africa/Luanda
+    { 519, 3 }, // Africa/Lubumbashi
+    { 537, 3 }, // Africa/Lusaka
+    { 551, 2 }, // Africa/Malabo
+    { 565, 3 }, // Africa/Maputo
+    { 579, 3 }, // Africa/Maseru
+    { 593, 3 }, // Africa/Mbabane
+    { 608, 1 }, // Africa/Mogadishu
+    { 625, 0 }, // Africa/Monrovia
+    { 641, 1 }, // Africa/Nairobi
+    { 656, 2 }, // Africa/Ndjamena
+    { 672, 2 }, // Africa/Niamey
+    { 686, 0 }, // Africa/Nouakchott
+    { 704, 0 }, // Africa/Ouagadougou
+    { 723, 2 }, // Africa/Porto-Novo
+    { 741, 0 }, // Africa/Sao_Tome
+    { 757, 3 }, // Africa/Tripoli
+    { 772, 2 }, // Africa/Tunis
+    { 785, 3 }, // Africa/Windhoek
+    { 801, 6 }, // America/Adak
+    { 814, 7 }, // America/Anchorage
+    { 832, 8 }, // America/Anguilla
+    { 849, 8 }, // America/Antigua
+    { 865, 9 }, // America/Araguaina
+    { 883, 9 }, // America/Argentina/Buenos_Aires
+    { 914, 9 }, // America/Argentina/Catamarca
+    { 942, 9 }, // America/Argentina/Cordoba
+    { 968, 9 }, // America/Argentina/Jujuy
+    { 992, 9 }, // America/Argentina/La_Rioja
+    { 1019, 9 }, // America/Argentina/Mendoza
+    { 1045, 9 }, // America/Argentina/Rio_Gallegos
+    { 1076, 9 }, // America/Argentina/Salta
+    { 1100, 9 }, // America/Argentina/San_Juan
+    { 1127, 9 }, // America/Argentina/San_Luis
+    { 1154, 9 }, // America/Argentina/Tucuman
+    { 1180, 9 }, // America/Argentina/Ushuaia
+    { 1206, 8 }, // America/Aruba
+    { 1220, 9 }, // America/Asuncion
+    { 1237, 10 }, // America/Atikokan
+    { 1254, 9 }, // America/Bahia
+    { 1268, 11 }, // America/Bahia_Banderas
+    { 1291, 8 }, // America/Barbados
+    { 1308, 9 }, // America/Belem
+    { 1322, 11 }, // America/Belize
+    { 1337, 8 }, // America/Blanc-Sablon
+    { 1358, 8 }, // America/Boa_Vista
+    { 1376, 10 }, // America/Bogota
+    { 1391, 12 }, // America/Boise
+    { 1405, 12 }, // America/Cambridge_Bay
+    { 1427, 8 }, // America/Campo_Grande
+    { 1448, 10 }, // America/Cancun
+    { 1463, 8 }, // America/Caracas
+    { 1479, 9 }, // America/Cayenne
+    { 1495, 10 }, // America/Cayman
+    { 1510, 13 }, // America/Chicago
+    { 1526, 11 }, // America/Chihuahua
+    { 1544, 11 }, // America/Costa_Rica
+    { 1563, 14 }, // America/Creston
+    { 1579, 8 }, // America/Cuiaba
+    { 1594, 8 }, // America/Curacao
+    { 1610, 0 }, // America/Danmarkshavn
+    { 1631, 14 }, // America/Dawson
+    { 1646, 14 }, // America/Dawson_Creek
+    { 1667, 12 }, // America/Denver
+    { 1682, 15 }, // America/Detroit
+    { 1698, 8 }, // America/Dominica
+    { 1715, 12 }, // America/Edmonton
+    { 1732, 10 }, // America/Eirunepe
+    { 1749, 11 }, // America/El_Salvador
+    { 1769, 9 }, // America/Fortaleza
+    { 1787, 14 }, // America/Fort_Nelson
+    { 1807, 16 }, // America/Glace_Bay
+    { 1825, 17 }, // America/Godthab
+    { 1841, 16 }, // America/Goose_Bay
+    { 1859, 15 }, // America/Grand_Turk
+    { 1878, 8 }, // America/Grenada
+    { 1894, 8 }, // America/Guadeloupe
+    { 1913, 11 }, // America/Guatemala
+    { 1931, 10 }, // America/Guayaquil
+    { 1949, 8 }, // America/Guyana
+    { 1964, 16 }, // America/Halifax
+    { 1980, 18 }, // America/Havana
+    { 1995, 14 }, // America/Hermosillo
+    { 2014, 15 }, // America/Indiana/Indianapolis
+    { 2043, 13 }, // America/Indiana/Knox
+    { 2064, 15 }, // America/Indiana/Marengo
+    { 2088, 15 }, // America/Indiana/Petersburg
+    { 2115, 13 }, // America/Indiana/Tell_City
+    { 2141, 15 }, // America/Indiana/Vevay
+    { 2163, 15 }, // America/Indiana/Vincennes
+    { 2189, 15 }, // America/Indiana/Winamac
+    { 2213, 12 }, // America/Inuvik
+    { 2228, 15 }, // America/Iqaluit
+    { 2244, 10 }, // America/Jamaica
+    { 2260, 7 }, // America/Juneau
+    { 2275, 15 }, // America/Kentucky/Louisville
+    { 2303, 15 }, // America/Kentucky/Monticello
+    { 2331, 8 }, // America/Kralendijk
+    { 2350, 8 }, // America/La_Paz
+    { 2365, 10 }, // America/Lima
+    { 2378, 19 }, // America/Los_Angeles
+    { 2398, 8 }, // America/Lower_Princes
+    { 2420, 9 }, // America/Maceio
+    { 2435, 11 }, // America/Managua
+    { 2451, 8 }, // America/Manaus
+    { 2466, 8 }, // America/Marigot
+    { 2482, 8 }, // America/Martinique
+    { 2501, 13 }, // America/Matamoros
+    { 2519, 14 }, // America/Mazatlan
+    { 2536, 13 }, // America/Menominee
+    { 2554, 11 }, // America/Merida
+    { 2569, 7 }, // America/Metlakatla
+    { 2588, 11 }, // America/Mexico_City
+    { 2608, 20 }, // America/Miquelon
+    { 2625, 16 }, // America/Moncton
+    { 2641, 11 }, // America/Monterrey
+    { 2659, 9 }, // America/Montevideo
+    { 2678, 15 }, // America/Montreal
+    { 2695, 8 }, // America/Montserrat
+    { 2714, 15 }, // America/Nassau
+    { 2729, 15 }, // America/New_York
+    { 2746, 15 }, // America/Nipigon
+    { 2762, 7 }, // America/Nome
+    { 2775, 21 }, // America/Noronha
+    { 2791, 13 }, // America/North_Dakota/Beulah
+    { 2819, 13 }, // America/North_Dakota/Center
+    { 2847, 13 }, // America/North_Dakota/New_Salem
+    { 2878, 13 }, // America/Ojinaga
+    { 2894, 10 }, // America/Panama
+    { 2909, 15 }, // America/Pangnirtung
+    { 2929, 9 }, // America/Paramaribo
+    { 2948, 14 }, // America/Phoenix
+    { 2964, 15 }, // America/Port-au-Prince
+    { 2987, 8 }, // America/Port_of_Spain
+    { 3009, 8 }, // America/Porto_Velho
+    { 3029, 8 }, // America/Puerto_Rico
+    { 3049, 9 }, // America/Punta_Arenas
+    { 3070, 13 }, // America/Rainy_River
+    { 3090, 13 }, // America/Rankin_Inlet
+    { 3111, 9 }, // America/Recife
+    { 3126, 11 }, // America/Regina
+    { 3141, 13 }, // America/Resolute
+    { 3158, 10 }, // America/Rio_Branco
+    { 3177, 9 }, // America/Santarem
+    { 3194, 22 }, // America/Santiago
+    { 3211, 8 }, // America/Santo_Domingo
+    { 3233, 9 }, // America/Sao_Paulo
+    { 3251, 17 }, // America/Scoresbysund
+    { 3272, 7 }, // America/Sitka
+    { 3286, 8 }, // America/St_Barthelemy
+    { 3308, 23 }, // America/St_Johns
+    { 3325, 8 }, // America/St_Kitts
+    { 3342, 8 }, // America/St_Lucia
+    { 3359, 8 }, // America/St_Thomas
+    { 3377, 8 }, // America/St_Vincent
+    { 3396, 11 }, // America/Swift_Current
+    { 3418, 11 }, // America/Tegucigalpa
+    { 3438, 16 }, // America/Thule
+    { 3452, 15 }, // America/Thunder_Bay
+    { 3472, 19 }, // America/Tijuana
+    { 3488, 15 }, // America/Toronto
+    { 3504, 8 }, // America/Tortola
+    { 3520, 19 }, // America/Vancouver
+    { 3538, 14 }, // America/Whitehorse
+    { 3557, 13 }, // America/Winnipeg
+    { 3574, 7 }, // America/Yakutat
+    { 3590, 12 }, // America/Yellowknife
+    { 3610, 24 }, // Antarctica/Casey
+    { 3627, 25 }, // Antarctica/Davis
+    { 3644, 26 }, // Antarctica/DumontDUrville
+    { 3670, 27 }, // Antarctica/Macquarie
+    { 3691, 28 }, // Antarctica/Mawson
+    { 3709, 29 }, // Antarctica/McMurdo
+    { 3728, 9 }, // Antarctica/Palmer
+    { 3746, 9 }, // Antarctica/Rothera
+    { 3765, 1 }, // Antarctica/Syowa
+    { 3782, 30 }, // Antarctica/Troll
+    { 3799, 28 }, // Antarctica/Vostok
+    { 3817, 5 }, // Arctic/Longyearbyen
+    { 3837, 1 }, // Asia/Aden
+    { 3847, 28 }, // Asia/Almaty
+    { 3859, 1 }, // Asia/Amman
+    { 3870, 31 }, // Asia/Anadyr
+    { 3882, 28 }, // Asia/Aqtau
+    { 3893, 28 }, // Asia/Aqtobe
+    { 3905, 28 }, // Asia/Ashgabat
+    { 3919, 28 }, // Asia/Atyrau
+    { 3931, 1 }, // Asia/Baghdad
+    { 3944, 1 }, // Asia/Bahrain
+    { 3957, 32 }, // Asia/Baku
+    { 3967, 25 }, // Asia/Bangkok
+    { 3980, 25 }, // Asia/Barnaul
+    { 3993, 33 }, // Asia/Beirut
+    { 4005, 34 }, // Asia/Bishkek
+    { 4018, 24 }, // Asia/Brunei
+    { 4030, 35 }, // Asia/Chita
+    { 4041, 24 }, // Asia/Choibalsan
+    { 4057, 36 }, // Asia/Colombo
+    { 4070, 1 }, // Asia/Damascus
+    { 4084, 34 }, // Asia/Dhaka
+    { 4095, 35 }, // Asia/Dili
+    { 4105, 32 }, // Asia/Dubai
+    { 4116, 28 }, // Asia/Dushanbe
+    { 4130, 37 }, // Asia/Famagusta
+    { 4145, 38 }, // Asia/Gaza
+    { 4155, 38 }, // Asia/Hebron
+    { 4167, 25 }, // Asia/Ho_Chi_Minh
+    { 4184, 24 }, // Asia/Hong_Kong
+    { 4199, 25 }, // Asia/Hovd
+    { 4209, 24 }, // Asia/Irkutsk
+    { 4222, 25 }, // Asia/Jakarta
+    { 4235, 35 }, // Asia/Jayapura
+    { 4249, 39 }, // Asia/Jerusalem
+    { 4264, 40 }, // Asia/Kabul
+    { 4275, 31 }, // Asia/Kamchatka
+    { 4290, 28 }, // Asia/Karachi
+    { 4303, 41 }, // Asia/Kathmandu
+    { 4318, 35 }, // Asia/Khandyga
+    { 4332, 36 }, // Asia/Kolkata
+    { 4345, 25 }, // Asia/Krasnoyarsk
+    { 4362, 24 }, // Asia/Kuala_Lumpur
+    { 4380, 24 }, // Asia/Kuching
+    { 4393, 1 }, // Asia/Kuwait
+    { 4405, 24 }, // Asia/Macau
+    { 4416, 42 }, // Asia/Magadan
+    { 4429, 24 }, // Asia/Makassar
+    { 4443, 24 }, // Asia/Manila
+    { 4455, 32 }, // Asia/Muscat
+    { 4467, 37 }, // Asia/Nicosia
+    { 4480, 25 }, // Asia/Novokuznetsk
+    { 4498, 25 }, // Asia/Novosibirsk
+    { 4515, 34 }, // Asia/Omsk
+    { 4525, 28 }, // Asia/Oral
+    { 4535, 25 }, // Asia/Phnom_Penh
+    { 4551, 25 }, // Asia/Pontianak
+    { 4566, 35 }, // Asia/Pyongyang
+    { 4581, 1 }, // Asia/Qatar
+    { 4592, 28 }, // Asia/Qyzylorda
+    { 4607, 1 }, // Asia/Riyadh
+    { 4619, 42 }, // Asia/Sakhalin
+    { 4633, 28 }, // Asia/Samarkand
+    { 4648, 35 }, // Asia/Seoul
+    { 4659, 24 }, // Asia/Shanghai
+    { 4673, 24 }, // Asia/Singapore
+    { 4688, 42 }, // Asia/Srednekolymsk
+    { 4707, 24 }, // Asia/Taipei
+    { 4719, 28 }, // Asia/Tashkent
+    { 4733, 32 }, // Asia/Tbilisi
+    { 4746, 43 }, // Asia/Tehran
+    { 4758, 34 }, // Asia/Thimphu
+    { 4771, 35 }, // Asia/Tokyo
+    { 4782, 25 }, // Asia/Tomsk
+    { 4793, 24 }, // Asia/Ulaanbaatar
+    { 4810, 34 }, // Asia/Urumqi
+    { 4822, 26 }, // Asia/Ust-Nera
+    { 4836, 25 }, // Asia/Vientiane
+    { 4851, 26 }, // Asia/Vladivostok
+    { 4868, 35 }, // Asia/Yakutsk
+    { 4881, 44 }, // Asia/Yangon
+    { 4893, 28 }, // Asia/Yekaterinburg
+    { 4912, 32 }, // Asia/Yerevan
+    { 4925, 45 }, // Atlantic/Azores
+    { 4941, 16 }, // Atlantic/Bermuda
+    { 4958, 46 }, // Atlantic/Canary
+    { 4974, 47 }, // Atlantic/Cape_Verde
+    { 4994, 46 }, // Atlantic/Faroe
+    { 5009, 46 }, // Atlantic/Madeira
+    { 5026, 0 }, // Atlantic/Reykjavik
+    { 5045, 21 }, // Atlantic/South_Georgia
+    { 5068, 9 }, // Atlantic/Stanley
+    { 5085, 0 }, // Atlantic/St_Helena
+    { 5104, 48 }, // Australia/Adelaide
+    { 5123, 26 }, // Australia/Brisbane
+    { 5142, 48 }, // Australia/Broken_Hill
+    { 5164, 27 }, // Australia/Currie
+    { 5181, 49 }, // Australia/Darwin
+    { 5198, 50 }, // Australia/Eucla
+    { 5214, 27 }, // Australia/Hobart
+    { 5231, 26 }, // Australia/Lindeman
+    { 5250, 51 }, // Australia/Lord_Howe
+    { 5270, 27 }, // Australia/Melbourne
+    { 5290, 24 }, // Australia/Perth
+    { 5306, 27 }, // Australia/Sydney
+    { 5323, 5 }, // Europe/Amsterdam
+    { 5340, 5 }, // Europe/Andorra
+    { 5355, 32 }, // Europe/Astrakhan
+    { 5372, 37 }, // Europe/Athens
+    { 5386, 5 }, // Europe/Belgrade
+    { 5402, 5 }, // Europe/Berlin
+    { 5416, 5 }, // Europe/Bratislava
+    { 5434, 5 }, // Europe/Brussels
+    { 5450, 37 }, // Europe/Bucharest
+    { 5467, 5 }, // Europe/Budapest
+    { 5483, 5 }, // Europe/Busingen
+    { 5499, 52 }, // Europe/Chisinau
+    { 5515, 5 }, // Europe/Copenhagen
+    { 5533, 53 }, // Europe/Dublin
+    { 5547, 5 }, // Europe/Gibraltar
+    { 5564, 46 }, // Europe/Guernsey
+    { 5580, 37 }, // Europe/Helsinki
+    { 5596, 46 }, // Europe/Isle_of_Man
+    { 5615, 1 }, // Europe/Istanbul
+    { 5631, 46 }, // Europe/Jersey
+    { 5645, 3 }, // Europe/Kaliningrad
+    { 5664, 37 }, // Europe/Kiev
+    { 5676, 1 }, // Europe/Kirov
+    { 5689, 46 }, // Europe/Lisbon
+    { 5703, 5 }, // Europe/Ljubljana
+    { 5720, 46 }, // Europe/London
+    { 5734, 5 }, // Europe/Luxembourg
+    { 5752, 5 }, // Europe/Madrid
+    { 5766, 5 }, // Europe/Malta
+    { 5779, 37 }, // Europe/Mariehamn
+    { 5796, 1 }, // Europe/Minsk
+    { 5809, 5 }, // Europe/Monaco
+    { 5823, 1 }, // Europe/Moscow
+    { 5837, 5 }, // Europe/Oslo
+    { 5849, 5 }, // Europe/Paris
+    { 5862, 5 }, // Europe/Podgorica
+    { 5879, 5 }, // Europe/Prague
+    { 5893, 37 }, // Europe/Riga
+    { 5905, 5 }, // Europe/Rome
+    { 5917, 32 }, // Europe/Samara
+    { 5931, 5 }, // Europe/San_Marino
+    { 5949, 5 }, // Europe/Sarajevo
+    { 5965, 32 }, // Europe/Saratov
+    { 5980, 1 }, // Europe/Simferopol
+    { 5998, 5 }, // Europe/Skopje
+    { 6012, 37 }, // Europe/Sofia
+    { 6025, 5 }, // Europe/Stockholm
+    { 6042, 37 }, // Europe/Tallinn
+    { 6057, 5 }, // Europe/Tirane
+    { 6071, 32 }, // Europe/Ulyanovsk
+    { 6088, 37 }, // Europe/Uzhgorod
+    { 6104, 5 }, // Europe/Vaduz
+    { 6117, 5 }, // Europe/Vatican
+    { 6132, 5 }, // Europe/Vienna
+    { 6146, 37 }, // Europe/Vilnius
+    { 6161, 1 }, // Europe/Volgograd
+    { 6178, 5 }, // Europe/Warsaw
+    { 6192, 5 }, // Europe/Zagreb
+    { 6206, 37 }, // Europe/Zaporozhye
+    { 6224, 5 }, // Europe/Zurich
+    { 6238, 1 }, // Indian/Antananarivo
+    { 6258, 34 }, // Indian/Chagos
+    { 6272, 25 }, // Indian/Christmas
+    { 6289, 44 }, // Indian/Cocos
+    { 6302, 1 }, // Indian/Comoro
+    { 6316, 28 }, // Indian/Kerguelen
+    { 6333, 32 }, // Indian/Mahe
+    { 6345, 28 }, // Indian/Maldives
+    { 6361, 32 }, // Indian/Mauritius
+    { 6378, 1 }, // Indian/Mayotte
+    { 6393, 32 }, // Indian/Reunion
+    { 6408, 54 }, // Pacific/Apia
+    { 6421, 29 }, // Pacific/Auckland
+    { 6438, 42 }, // Pacific/Bougainville
+    { 6459, 55 }, // Pacific/Chatham
+    { 6475, 26 }, // Pacific/Chuuk
+    { 6489, 56 }, // Pacific/Easter
+    { 6504, 42 }, // Pacific/Efate
+    { 6518, 54 }, // Pacific/Enderbury
+    { 6536, 54 }, // Pacific/Fakaofo
+    { 6552, 31 }, // Pacific/Fiji
+    { 6565, 31 }, // Pacific/Funafuti
+    { 6582, 11 }, // Pacific/Galapagos
+    { 6600, 57 }, // Pacific/Gambier
+    { 6616, 42 }, // Pacific/Guadalcanal
+    { 6636, 26 }, // Pacific/Guam
+    { 6649, 58 }, // Pacific/Honolulu
+    { 6666, 59 }, // Pacific/Kiritimati
+    { 6685, 42 }, // Pacific/Kosrae
+    { 6700, 31 }, // Pacific/Kwajalein
+    { 6718, 31 }, // Pacific/Majuro
+    { 6733, 60 }, // Pacific/Marquesas
+    { 6751, 61 }, // Pacific/Midway
+    { 6766, 31 }, // Pacific/Nauru
+    { 6780, 61 }, // Pacific/Niue
+    { 6793, 62 }, // Pacific/Norfolk
+    { 6809, 42 }, // Pacific/Noumea
+    { 6824, 61 }, // Pacific/Pago_Pago
+    { 6842, 35 }, // Pacific/Palau
+    { 6856, 63 }, // Pacific/Pitcairn
+    { 6873, 42 }, // Pacific/Pohnpei
+    { 6889, 26 }, // Pacific/Port_Moresby
+    { 6910, 58 }, // Pacific/Rarotonga
+    { 6928, 26 }, // Pacific/Saipan
+    { 6943, 58 }, // Pacific/Tahiti
+    { 6958, 31 }, // Pacific/Tarawa
+    { 6973, 54 }, // Pacific/Tongatapu
+    { 6991, 31 }, // Pacific/Wake
+    { 7004, 31 }, // Pacific/Wallis
+};
+
+// Zones sorted by name, for binary searches
+static const uint16_t tzdbSorted[TZDB_ZONE_COUNT] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+    64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79,
+    80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95,
+    96, 97, 98, 99, 100, 101, 103, 102, 104, 105, 106, 107, 108, 109, 110, 111,
+    112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127,
+    128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143,
+    144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159,
+    160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175,
+    176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191,
+    192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
+    208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223,
+    224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239,
+    240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255,
+    256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 269, 270, 271,
+    272, 273, 274, 275, 276, 277, 278, 279, 280, 281, 282, 283, 284, 285, 286, 287,
+    288, 289, 290, 291, 292, 293, 294, 295, 296, 297, 298, 299, 300, 301, 303, 302,
+    304, 305, 306, 307, 308, 309, 310, 311, 312, 313, 314, 315, 316, 317, 318, 319,
+    320, 321, 322, 323, 324, 325, 326, 327, 328, 329, 330, 331, 332, 333, 334, 335,
+    336, 337, 338, 339, 340, 341, 342, 343, 344, 345, 346, 347, 348, 349, 350, 351,
+    352, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362, 363, 364, 365, 366, 367,
+    368, 369, 370, 371, 372, 373, 374, 375, 376, 377, 378, 379, 380, 381, 382, 383,
+    384, 385, 386, 387, 388, 389, 390, 391, 392, 393, 394, 395, 396, 397, 398, 399,
+    400, 401, 402, 403, 404, 405, 406, 407, 408, 409, 410, 411, 412, 413, 414, 415,
+    416, 417, 418, 419, 420, 421, 422, 423, 424,
+};
+
+// Position in tzdbSorted of the first zone of each region (the part of the name before the first /)
+static const uint16_t tzdbRegions[TZDB_REGION_COUNT] = {
+    0, 52, 200, 211, 212, 294, 304, 316, 376, 387,
+};
+
+// Zones sorted by the search key of the city (the part of the name after the last /)
+static const uint16_t tzdbByCity[TZDB_ZONE_COUNT] = {
+    0, 1, 52, 2, 304, 212, 3, 213, 214, 316, 215, 53, 317, 54, 376, 55,
+    387, 216, 217, 56, 69, 218, 4, 318, 70, 319, 71, 219, 388, 294, 220, 72,
+    73, 221, 222, 5, 223, 6, 7, 74, 224, 225, 75, 320, 76, 321, 295, 157,
+    226, 8, 77, 9, 78, 79, 80, 389, 322, 10, 305, 306, 227, 323, 324, 325,
+    57, 11, 326, 12, 81, 82, 296, 83, 297, 84, 13, 200, 58, 85, 86, 158,
+    14, 377, 390, 87, 88, 327, 228, 229, 378, 391, 379, 230, 380, 15, 328, 59,
+    89, 90, 91, 92, 307, 16, 231, 93, 17, 308, 201, 94, 95, 96, 97, 232,
+    233, 18, 98, 19, 234, 329, 202, 235, 392, 99, 393, 100, 20, 101, 394, 309,
+    395, 236, 298, 396, 102, 103, 21, 397, 22, 398, 399, 237, 330, 104, 105, 106,
+    107, 108, 400, 109, 401, 110, 111, 331, 112, 113, 23, 114, 238, 332, 115, 310,
+    239, 240, 402, 241, 116, 124, 125, 242, 333, 334, 243, 126, 244, 335, 245, 24,
+    25, 60, 127, 246, 336, 247, 26, 248, 249, 381, 250, 27, 337, 28, 29, 403,
+    338, 117, 251, 404, 130, 252, 253, 254, 255, 405, 30, 131, 61, 31, 132, 311,
+    339, 340, 32, 341, 211, 312, 133, 128, 134, 33, 34, 35, 342, 256, 135, 203,
+    299, 343, 257, 382, 406, 258, 36, 383, 344, 136, 137, 259, 37, 118, 345, 138,
+    407, 139, 38, 140, 384, 204, 385, 141, 39, 205, 313, 62, 142, 143, 144, 145,
+    408, 346, 146, 40, 347, 147, 41, 148, 149, 129, 150, 151, 348, 260, 42, 152,
+    409, 43, 159, 153, 44, 261, 154, 410, 155, 411, 156, 45, 412, 262, 263, 160,
+    264, 265, 349, 46, 413, 414, 206, 161, 162, 163, 350, 314, 119, 266, 164, 415,
+    351, 416, 267, 165, 417, 166, 47, 167, 352, 168, 169, 268, 269, 270, 170, 171,
+    418, 172, 173, 174, 386, 300, 353, 175, 63, 271, 354, 207, 419, 272, 64, 355,
+    273, 65, 66, 356, 176, 177, 178, 179, 48, 357, 358, 180, 274, 275, 359, 276,
+    181, 360, 361, 301, 277, 302, 182, 303, 183, 184, 185, 362, 186, 187, 188, 315,
+    208, 420, 278, 363, 421, 279, 280, 189, 281, 120, 282, 190, 191, 192, 364, 283,
+    284, 422, 193, 194, 49, 209, 67, 50, 285, 365, 286, 68, 287, 366, 367, 195,
+    368, 121, 369, 288, 370, 122, 289, 371, 210, 423, 424, 372, 196, 123, 51, 197,
+    198, 290, 291, 292, 199, 293, 373, 374, 375,
+};
+
+// Zones sorted by the search key of the whole name
+static const uint16_t tzdbByName[TZDB_ZONE_COUNT] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+    64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79,
+    80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95,
+    96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111,
+    112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127,
+    128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143,
+    144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159,
+    160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175,
+    176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191,
+    192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
+    208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223,
+    224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239,
+    240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255,
+    256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 269, 270, 271,
+    272, 273, 274, 275, 276, 277, 278, 279, 280, 281, 282, 283, 284, 285, 286, 287,
+    288, 289, 290, 291, 292, 293, 294, 295, 296, 297, 298, 299, 300, 301, 302, 303,
+    304, 305, 306, 307, 308, 309, 310, 311, 312, 313, 314, 315, 316, 317, 318, 319,
+    320, 321, 322, 323, 324, 325, 326, 327, 328, 329, 330, 331, 332, 333, 334, 335,
+    336, 337, 338, 339, 340, 341, 342, 343, 344, 345, 346, 347, 348, 349, 350, 351,
+    352, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362, 363, 364, 365, 366, 367,
+    368, 369, 370, 371, 372, 373, 374, 375, 376, 377, 378, 379, 380, 381, 382, 383,
+    384, 385, 386, 387, 388, 389, 390, 391, 392, 393, 394, 395, 396, 397, 398, 399,
+    400, 401, 402, 403, 404, 405, 406, 407, 408, 409, 410, 411, 412, 413, 414, 415,
+    416, 417, 418, 419, 420, 421, 422, 423, 424,
+};
+
+static const TzRule tzdbRules[TZDB_RULE_COUNT] = {
+    { 0, 0, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 10800, 10800, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 3600, 3600, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 7200, 7200, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 7200, 10800, true, { 2, 4, 5, 5, 0, 0 }, { 2, 10, 5, 4, 0, 86400 } },
+    { 3600, 7200, true, { 2, 3, 5, 0, 0, 7200 }, { 2, 10, 5, 0, 0, 10800 } },
+    { -36000, -32400, true, { 2, 3, 2, 0, 0, 7200 }, { 2, 11, 1, 0, 0, 7200 } },
+    { -32400, -28800, true, { 2, 3, 2, 0, 0, 7200 }, { 2, 11, 1, 0, 0, 7200 } },
+    { -14400, -14400, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { -10800, -10800, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { -18000, -18000, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { -21600, -21600, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { -25200, -21600, true, { 2, 3, 2, 0, 0, 7200 }, { 2, 11, 1, 0, 0, 7200 } },
+    { -21600, -18000, true, { 2, 3, 2, 0, 0, 7200 }, { 2, 11, 1, 0, 0, 7200 } },
+    { -25200, -25200, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { -18000, -14400, true, { 2, 3, 2, 0, 0, 7200 }, { 2, 11, 1, 0, 0, 7200 } },
+    { -14400, -10800, true, { 2, 3, 2, 0, 0, 7200 }, { 2, 11, 1, 0, 0, 7200 } },
+    { -7200, -3600, true, { 2, 3, 5, 0, 0, -3600 }, { 2, 10, 5, 0, 0, 0 } },
+    { -18000, -14400, true, { 2, 3, 2, 0, 0, 0 }, { 2, 11, 1, 0, 0, 3600 } },
+    { -28800, -25200, true, { 2, 3, 2, 0, 0, 7200 }, { 2, 11, 1, 0, 0, 7200 } },
+    { -10800, -7200, true, { 2, 3, 2, 0, 0, 7200 }, { 2, 11, 1, 0, 0, 7200 } },
+    { -7200, -7200, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { -14400, -10800, true, { 2, 9, 1, 6, 0, 86400 }, { 2, 4, 1, 6, 0, 86400 } },
+    { -12600, -9000, true, { 2, 3, 2, 0, 0, 7200 }, { 2, 11, 1, 0, 0, 7200 } },
+    { 28800, 28800, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 25200, 25200, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 36000, 36000, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 36000, 39600, true, { 2, 10, 1, 0, 0, 7200 }, { 2, 4, 1, 0, 0, 10800 } },
+    { 18000, 18000, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 43200, 46800, true, { 2, 9, 5, 0, 0, 7200 }, { 2, 4, 1, 0, 0, 10800 } },
+    { 0, 7200, true, { 2, 3, 5, 0, 0, 3600 }, { 2, 10, 5, 0, 0, 10800 } },
+    { 43200, 43200, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 14400, 14400, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 7200, 10800, true, { 2, 3, 5, 0, 0, 0 }, { 2, 10, 5, 0, 0, 0 } },
+    { 21600, 21600, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 32400, 32400, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 19800, 19800, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 7200, 10800, true, { 2, 3, 5, 0, 0, 10800 }, { 2, 10, 5, 0, 0, 14400 } },
+    { 7200, 10800, true, { 2, 3, 4, 4, 0, 180000 }, { 2, 10, 4, 4, 0, 180000 } },
+    { 7200, 10800, true, { 2, 3, 4, 4, 0, 93600 }, { 2, 10, 5, 0, 0, 7200 } },
+    { 16200, 16200, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 20700, 20700, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 39600, 39600, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 12600, 12600, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 23400, 23400, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { -3600, 0, true, { 2, 3, 5, 0, 0, 0 }, { 2, 10, 5, 0, 0, 3600 } },
+    { 0, 3600, true, { 2, 3, 5, 0, 0, 3600 }, { 2, 10, 5, 0, 0, 7200 } },
+    { -3600, -3600, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 34200, 37800, true, { 2, 10, 1, 0, 0, 7200 }, { 2, 4, 1, 0, 0, 10800 } },
+    { 34200, 34200, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 31500, 31500, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 37800, 39600, true, { 2, 10, 1, 0, 0, 7200 }, { 2, 4, 1, 0, 0, 7200 } },
+    { 7200, 10800, true, { 2, 3, 5, 0, 0, 7200 }, { 2, 10, 5, 0, 0, 10800 } },
+    { 3600, 0, true, { 2, 10, 5, 0, 0, 7200 }, { 2, 3, 5, 0, 0, 3600 } },
+    { 46800, 46800, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 45900, 49500, true, { 2, 9, 5, 0, 0, 9900 }, { 2, 4, 1, 0, 0, 13500 } },
+    { -21600, -18000, true, { 2, 9, 1, 6, 0, 79200 }, { 2, 4, 1, 6, 0, 79200 } },
+    { -32400, -32400, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { -36000, -36000, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 50400, 50400, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { -34200, -34200, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { -39600, -39600, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+    { 39600, 43200, true, { 2, 10, 1, 0, 0, 7200 }, { 2, 4, 1, 0, 0, 10800 } },
+    { -28800, -28800, false, { 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0 } },
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include "tzif.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TZIF_HEADER_SIZE 44
+
+static uint32_t readBE32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static int64_t readBE64(const uint8_t *p)
+{
+    return (int64_t)(((uint64_t)readBE32(p) << 32) | readBE32(p + 4));
+}
+
+// Reads the counts of a header and returns the size of the data block following it or 0 if it's invalid
+static uint32_t readHeader(const uint8_t *p, uint32_t size, uint32_t timeSize, uint32_t *timecnt, uint32_t *typecnt, uint32_t *leapcnt)
+{
+    if(size < TZIF_HEADER_SIZE || memcmp(p, "TZif", 4) != 0)
+        return 0;
+
+    uint32_t isutcnt = readBE32(p + 20);
+    uint32_t isstdcnt = readBE32(p + 24);
+    *leapcnt = readBE32(p + 28);
+    *timecnt = readBE32(p + 32);
+    *typecnt = readBE32(p + 36);
+    uint32_t charcnt = readBE32(p + 40);
+
+    // Sane limits, so the sum below can't overflow
+    if(*timecnt > 0xFFFF || *typecnt == 0 || *typecnt > 256 || *leapcnt > 0xFFFF || isutcnt > 256 || isstdcnt > 256 || charcnt > 0xFFFF)
+        return 0;
+
+    uint32_t data = *timecnt * timeSize + *timecnt + *typecnt * 6 + charcnt + *leapcnt * (timeSize + 4) + isstdcnt + isutcnt;
+    return data <= size - TZIF_HEADER_SIZE ? data : 0;
+}
+
+bool tzifParse(const uint8_t *buf, uint32_t size, TzifData *tzif)
+{
+    uint32_t timecnt, typecnt, leapcnt;
+
+    // Skip the 32 bit data of version 1
+    uint32_t data = readHeader(buf, size, 4, &timecnt, &typecnt, &leapcnt);
+    if(data == 0 || buf[4] < '2')
+        return false;
+
+    buf += TZIF_HEADER_SIZE + data;
+    size -= TZIF_HEADER_SIZE + data;
+
+    data = readHeader(buf, size, 8, &timecnt, &typecnt, &leapcnt);
+    // Files with leap seconds count TAI like seconds, the console counts POSIX time
+    if(data == 0 || leapcnt != 0)
+        return false;
+
+    tzif->transitions = buf + TZIF_HEADER_SIZE;
+    tzif->types = tzif->transitions + timecnt * 8;
+    tzif->ttinfos = tzif->types + timecnt;
+    tzif->timecnt = timecnt;
+    tzif->typecnt = typecnt;
+
+    for(uint32_t i = 0; i < timecnt; ++i)
+        if(tzif->types[i] >= typecnt)
+            return false;
+
+    // The footer is a POSIX TZ string between two newlines
+    const char *footer = (const char *)buf + TZIF_HEADER_SIZE + data;
+    size -= TZIF_HEADER_SIZE + data;
+    tzif->hasFooter = false;
+    if(size >= 2 && footer[0] == '\n')
+    {
+        char tz[64];
+        uint32_t len = 1;
+        while(len < size && footer[len] != '\n')
+            ++len;
+
+        if(len < size && len - 1 < sizeof(tz) && len > 1)
+        {
+            memcpy(tz, footer + 1, len - 1);
+            tz[len - 1] = '\0';
+            tzif->hasFooter = tzParse(tz, &tzif->footer);
+        }
+    }
+
+    return true;
+}
+
+// Reads the whole file into buf at once. The buffer has to stay untouched as long as tzif is used.
+bool tzifLoad(const char *path, uint8_t *buf, uint32_t size, TzifData *tzif)
+{
+    FILE *file = fopen(path, "rb");
+    if(file == NULL)
+        return false;
+
+    size_t read = fread(buf, 1, size, file);
+    bool complete = feof(file) && !ferror(file);
+    fclose(file);
+
+    return complete && tzifParse(buf, read, tzif);
+}
+
+static int32_t typeOffset(const TzifData *tzif, uint32_t type)
+{
+    return (int32_t)readBE32(tzif->ttinfos + type * 6);
+}
+
+// Returns the UTC offset in effect at utc. *next is set to the next time it might change or 0 if it never does.
+int32_t tzifOffset(const TzifData *tzif, int64_t utc, int64_t *next)
+{
+    *next = 0;
+
+    // Before the first transition the first local time type is in effect
+    if(tzif->timecnt == 0 || utc < readBE64(tzif->transitions))
+    {
+        if(tzif->timecnt != 0)
+            *next = readBE64(tzif->transitions);
+        else if(tzif->hasFooter)
+            return tzOffset(&tzif->footer, utc, next);
+
+        return typeOffset(tzif, 0);
+    }
+
+    // Find the last transition at or before utc
+    uint32_t low = 0;
+    uint32_t high = tzif->timecnt;
+    while(high - low > 1)
+    {
+        uint32_t mid = (low + high) / 2;
+        if(readBE64(tzif->transitions + mid * 8) <= utc)
+            low = mid;
+        else
+            high = mid;
+    }
+
+    if(high < tzif->timecnt)
+    {
+        *next = readBE64(tzif->transitions + high * 8);
+        return typeOffset(tzif, tzif->types[low]);
+    }
+
+    // Past the table the footer continues it
+    if(tzif->hasFooter)
+        return tzOffset(&tzif->footer, utc, next);
+
+    return typeOffset(tzif, tzif->types[low]);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "tzrule.h"
+#include <wut.h>
+
+// Reads TZif files (RFC 8536, version 2 and up) in place: the data is never copied out of the buffer the file
+// got loaded into, lookups binary search the transitions directly in it.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct TzifData {
+    const uint8_t *transitions; // 64 bit big endian UTC times, ascending
+    const uint8_t *types;       // Local time type index of each transition
+    const uint8_t *ttinfos;     // Local time types, 6 bytes each: 32 bit big endian UTC offset, is DST, abbreviation index
+    uint32_t timecnt;
+    uint32_t typecnt;
+    bool hasFooter;
+    TzRule footer; // Rule for the times after the last transition
+} TzifData;
+
+bool tzifParse(const uint8_t *buf, uint32_t size, TzifData *tzif);
+bool tzifLoad(const char *path, uint8_t *buf, uint32_t size, TzifData *tzif);
+int32_t tzifOffset(const TzifData *tzif, int64_t utc, int64_t *next);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,245 @@
+#include "tzrule.h"
+
+#define SECONDS_PER_DAY 86400
+
+// Days since 1970-01-01 of a date of the proleptic Gregorian calendar
+static int64_t daysFromCivil(int64_t year, uint32_t month, uint32_t day)
+{
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    uint32_t yoe = (uint32_t)(year - era * 400);
+    uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+static int64_t yearFromDays(int64_t days)
+{
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    uint32_t doe = (uint32_t)(days - era * 146097);
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    return (int64_t)yoe + era * 400 + (mp >= 10);
+}
+
+static bool isLeapYear(int64_t year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static uint32_t daysInMonth(int64_t year, uint32_t month)
+{
+    static const uint8_t days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+}
+
+// Local midnight of the transition day, in days since the epoch
+static int64_t transitionDay(const TzRuleDate *date, int64_t year)
+{
+    int64_t jan1 = daysFromCivil(year, 1, 1);
+
+    if(date->type == TZ_DATE_JULIAN)
+        return jan1 + date->day - 1 + (isLeapYear(year) && date->day >= 60);
+    if(date->type == TZ_DATE_ZERO_BASED)
+        return jan1 + date->day;
+
+    int64_t first = daysFromCivil(year, date->month, 1);
+    // 1970-01-01 was a thursday
+    uint32_t firstWeekday = (uint32_t)(((first % 7) + 11) % 7);
+    uint32_t day = 1 + ((date->weekday + 7 - firstWeekday) % 7) + (date->week - 1) * 7;
+    uint32_t last = daysInMonth(year, date->month);
+    while(day > last)
+        day -= 7;
+
+    return first + day - 1;
+}
+
+// Parses a number of up to max, returns NULL if there is none
+static const char *parseNumber(const char *str, uint32_t max, uint32_t *out)
+{
+    if(*str < '0' || *str > '9')
+        return NULL;
+
+    uint32_t value = 0;
+    do
+    {
+        value = value * 10 + (*str++ - '0');
+        if(value > max)
+            return NULL;
+    } while(*str >= '0' && *str <= '9');
+
+    *out = value;
+    return str;
+}
+
+// [+|-]hh[:mm[:ss]]
+static const char *parseTime(const char *str, uint32_t maxHours, int32_t *out)
+{
+    bool negative = *str == '-';
+    if(*str == '-' || *str == '+')
+        ++str;
+
+    uint32_t hours, minutes = 0, seconds = 0;
+    str = parseNumber(str, maxHours, &hours);
+    if(str != NULL && *str == ':')
+    {
+        str = parseNumber(str + 1, 59, &minutes);
+        if(str != NULL && *str == ':')
+            str = parseNumber(str + 1, 59, &seconds);
+    }
+
+    if(str == NULL)
+        return NULL;
+
+    *out = (int32_t)(hours * 3600 + minutes * 60 + seconds);
+    if(negative)
+        *out = -*out;
+
+    return str;
+}
+
+// Either <...> or at least three letters
+static const char *parseName(const char *str)
+{
+    const char *start = str;
+    if(*str == '<')
+    {
+        while(*++str != '>')
+            if(*str == '\0')
+                return NULL;
+
+        return str + 1;
+    }
+
+    while((*str >= 'A' && *str <= 'Z') || (*str >= 'a' && *str <= 'z'))
+        ++str;
+
+    return str - start >= 3 ? str : NULL;
+}
+
+static const char *parseDate(const char *str, TzRuleDate *date)
+{
+    uint32_t value;
+    if(*str == 'M')
+    {
+        uint32_t week, weekday;
+        str = parseNumber(str + 1, 12, &value);
+        if(str == NULL || value == 0 || *str != '.' || (str = parseNumber(str + 1, 5, &week)) == NULL || week == 0 || *str != '.' || (str = parseNumber(str + 1, 6, &weekday)) == NULL)
+            return NULL;
+
+        date->type = TZ_DATE_MONTH;
+        date->month = value;
+        date->week = week;
+        date->weekday = weekday;
+    }
+    else if(*str == 'J')
+    {
+        str = parseNumber(str + 1, 365, &value);
+        if(str == NULL || value == 0)
+            return NULL;
+
+        date->type = TZ_DATE_JULIAN;
+        date->day = value;
+    }
+    else
+    {
+        str = parseNumber(str, 365, &value);
+        if(str == NULL)
+            return NULL;
+
+        date->type = TZ_DATE_ZERO_BASED;
+        date->day = value;
+    }
+
+    date->time = 2 * 3600;
+    if(*str == '/')
+        str = parseTime(str + 1, 167, &date->time);
+
+    return str;
+}
+
+bool tzParse(const char *tz, TzRule *rule)
+{
+    int32_t offset;
+    const char *str = parseName(tz);
+    if(str == NULL || (str = parseTime(str, 24, &offset)) == NULL)
+        return false;
+
+    // POSIX offsets count west of UTC
+    rule->stdOffset = -offset;
+    rule->hasDst = *str != '\0';
+    if(!rule->hasDst)
+    {
+        rule->dstOffset = rule->stdOffset;
+        return true;
+    }
+
+    if((str = parseName(str)) == NULL)
+        return false;
+
+    rule->dstOffset = rule->stdOffset + 3600;
+    if(*str != ',' && *str != '\0')
+    {
+        if((str = parseTime(str, 24, &offset)) == NULL)
+            return false;
+
+        rule->dstOffset = -offset;
+    }
+
+    if(*str == '\0')
+    {
+        // No rule, POSIX leaves that to the implementation. Use the US rules like glibc.
+        str = ",M3.2.0,M11.1.0";
+    }
+
+    if(*str != ',' || (str = parseDate(str + 1, &rule->start)) == NULL || *str != ',' || (str = parseDate(str + 1, &rule->end)) == NULL)
+        return false;
+
+    return *str == '\0';
+}
+
+// Returns the UTC offset in effect at utc. *next is set to the next time it might change or 0 if it never does.
+int32_t tzOffset(const TzRule *rule, int64_t utc, int64_t *next)
+{
+    *next = 0;
+    if(!rule->hasDst)
+        return rule->stdOffset;
+
+    // The transitions of the year before and after cover rules that cross new year
+    int64_t year = yearFromDays((utc >= 0 ? utc : utc - (SECONDS_PER_DAY - 1)) / SECONDS_PER_DAY);
+    int64_t times[6];
+    bool dst[6];
+    uint32_t count = 0;
+
+    for(int64_t y = year - 1; y <= year + 1; ++y)
+    {
+        for(uint32_t i = 0; i < 2; ++i)
+        {
+            const TzRuleDate *date = i == 0 ? &rule->start : &rule->end;
+            int64_t time = transitionDay(date, y) * SECONDS_PER_DAY + date->time - (i == 0 ? rule->stdOffset : rule->dstOffset);
+
+            // Keep them sorted
+            uint32_t j = count++;
+            for(; j > 0 && times[j - 1] > time; --j)
+            {
+                times[j] = times[j - 1];
+                dst[j] = dst[j - 1];
+            }
+
+            times[j] = time;
+            dst[j] = i == 0;
+        }
+    }
+
+    uint32_t i = 0;
+    while(i < count && times[i] <= utc)
+        ++i;
+
+    if(i < count)
+        *next = times[i];
+
+    // Before the first transition the zone is in whatever the last one of the year before left it in
+    return (i == 0 ? !dst[0] : dst[i - 1]) ? rule->dstOffset : rule->stdOffset;
+}
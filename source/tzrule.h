@@ -0,0 +1,39 @@
+#pragma once
+#include <wut.h>
+
+// Evaluates POSIX TZ strings like "CET-1CEST,M3.5.0,M10.5.0/3" without libc: no environment, no allocations,
+// no global state. Offsets are in seconds east of UTC, times in seconds since the Unix epoch.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum TzDateType {
+    TZ_DATE_JULIAN,     // Jn: Day 1 - 365, February 29th is never counted
+    TZ_DATE_ZERO_BASED, // n: Day 0 - 365, February 29th is counted
+    TZ_DATE_MONTH,      // Mm.w.d: Day d (0 = Sunday) of week w (5 = last) of month m
+} TzDateType;
+
+typedef struct TzRuleDate {
+    uint8_t type;
+    uint8_t month;
+    uint8_t week;
+    uint8_t weekday;
+    uint16_t day;
+    int32_t time; // Local time of the transition in seconds after midnight, might be negative or beyond a day
+} TzRuleDate;
+
+typedef struct TzRule {
+    int32_t stdOffset;
+    int32_t dstOffset;
+    bool hasDst;
+    TzRuleDate start; // Given in standard time
+    TzRuleDate end;   // Given in daylight saving time
+} TzRule;
+
+bool tzParse(const char *tz, TzRule *rule);
+int32_t tzOffset(const TzRule *rule, int64_t utc, int64_t *next);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,15 @@
+#pragma once
+// Host stand-in for coreinit/memory.h
+#include <wut.h>
+#include <string.h>
+
+static inline void *OSBlockSet(void *dst, uint8_t val, uint32_t size)
+{
+    return memset(dst, val, size);
+}
+
+static inline void *OSBlockMove(void *dst, const void *src, uint32_t size, bool flush)
+{
+    (void)flush;
+    return memmove(dst, src, size);
+}
@@ -0,0 +1,22 @@
+#pragma once
+// Host stand-in for coreinit/time.h. OSGetTime() is provided by each test, so it controls the clock.
+#include <wut.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int64_t OSTime;
+
+OSTime OSGetTime(void);
+
+// The bus clock of a retail console
+#define OSTimerClockSpeed (248625000 / 4)
+
+#define OSSecondsToTicks(val)       ((uint64_t)(val) * (uint64_t)OSTimerClockSpeed)
+#define OSMillisecondsToTicks(val)  (((uint64_t)(val) * (uint64_t)OSTimerClockSpeed) / 1000ull)
+#define OSNanosecondsToTicks(val)   (((uint64_t)(val) * (OSTimerClockSpeed / 31250)) / 32000)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,11 @@
+#pragma once
+// Host stand-in for nn/pdm.h, the play time tracking has nothing to do on a host
+
+namespace nn
+{
+    namespace pdm
+    {
+        static inline void NotifySetTimeBeginEvent() { }
+        static inline void NotifySetTimeEndEvent() { }
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+// Host stand-in for the parts of wut.h the tested sources use
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define WUT_PACKED __attribute__((__packed__))
+
+#ifdef __cplusplus
+#define WUT_CHECK_OFFSET(type, offset, field) static_assert(offsetof(type, field) == offset, #type "." #field " is at the wrong offset")
+#define WUT_CHECK_SIZE(type, size) static_assert(sizeof(type) == size, #type " has the wrong size")
+#else
+#define WUT_CHECK_OFFSET(type, offset, field) _Static_assert(offsetof(type, field) == offset, #type "." #field " is at the wrong offset")
+#define WUT_CHECK_SIZE(type, size) _Static_assert(sizeof(type) == size, #type " has the wrong size")
+#endif
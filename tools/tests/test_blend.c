@@ -0,0 +1,120 @@
+// Host test of the keyboard's pixel kernels. blendSpan() is checked against the exactly rounded blend for
+// every source, destination and coverage value. With --bench it's timed against the float per pixel blend
+// the keyboard used before, on glyph sized spans. Host timings only say how the two compare.
+#include "blend.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_GLYPH 24        // Pixels per side, the size of the keyboard's key labels
+#define BENCH_ROUNDS 200000
+
+static uint32_t reference(uint32_t s, uint32_t d, uint32_t a)
+{
+    return ((s * a) + (d * (0xFF - a)) + 127) / 255;
+}
+
+static bool testGolden(void)
+{
+    uint8_t coverage[256];
+    uint32_t dst[256];
+    long failures = 0;
+
+    for(uint32_t a = 0; a < 256; ++a)
+        coverage[a] = (uint8_t)a;
+
+    // Every lane sees every (source, destination) pair, the other lanes the swapped one
+    for(uint32_t s = 0; s < 256; ++s)
+        for(uint32_t d = 0; d < 256; ++d)
+        {
+            uint32_t color = (s << 24) | (d << 16) | (s << 8) | d;
+            uint32_t background = (d << 24) | (s << 16) | (d << 8) | s;
+            for(uint32_t a = 0; a < 256; ++a)
+                dst[a] = background;
+
+            blendSpan(dst, coverage, 256, color);
+
+            for(uint32_t a = 0; a < 256; ++a)
+            {
+                uint32_t sd = reference(s, d, a);
+                uint32_t ds = reference(d, s, a);
+                uint32_t want = (sd << 24) | (ds << 16) | (sd << 8) | ds;
+                if(dst[a] != want)
+                {
+                    if(failures < 5)
+                        printf("s %u d %u a %u: %08x, want %08x\n", s, d, a, dst[a], want);
+                    ++failures;
+                }
+            }
+
+            // The ends are no blends at all
+            if(dst[0] != background || dst[255] != color)
+                ++failures;
+        }
+
+    if(failures != 0)
+        printf("test_blend: %ld failures\n", failures);
+
+    return failures == 0;
+}
+
+// The blend of the old drawPixel(), for comparison
+static void floatSpan(uint32_t *dst, const uint8_t *coverage, uint32_t n, uint32_t color)
+{
+    for(uint32_t i = 0; i < n; ++i)
+    {
+        if(coverage[i] == 0)
+            continue;
+
+        float f = coverage[i] / 255.0f;
+        uint8_t *px = (uint8_t *)(dst + i);
+        px[0] = (uint8_t)((((color >> 24) & 0xFF) * f) + (px[0] * (1.0f - f)));
+        px[1] = (uint8_t)((((color >> 16) & 0xFF) * f) + (px[1] * (1.0f - f)));
+        px[2] = (uint8_t)((((color >> 8) & 0xFF) * f) + (px[2] * (1.0f - f)));
+    }
+}
+
+static double bench(void (*span)(uint32_t *, const uint8_t *, uint32_t, uint32_t), uint32_t *dst, const uint8_t *coverage)
+{
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(uint32_t r = 0; r < BENCH_ROUNDS; ++r)
+        for(uint32_t y = 0; y < BENCH_GLYPH; ++y)
+            span(dst + (y * BENCH_GLYPH), coverage + (y * BENCH_GLYPH), BENCH_GLYPH, r & 0xFFFFFF00);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double ns = ((end.tv_sec - start.tv_sec) * 1e9) + (end.tv_nsec - start.tv_nsec);
+    return ns / ((double)BENCH_ROUNDS * BENCH_GLYPH * BENCH_GLYPH);
+}
+
+static void runBench(void)
+{
+    // Like an antialiased glyph: mostly empty, some solid, the rest edges
+    static uint8_t coverage[BENCH_GLYPH * BENCH_GLYPH];
+    static uint32_t dst[BENCH_GLYPH * BENCH_GLYPH];
+    srand(1);
+    for(uint32_t i = 0; i < BENCH_GLYPH * BENCH_GLYPH; ++i)
+    {
+        int r = rand() % 10;
+        coverage[i] = r < 6 ? 0 : r < 8 ? 0xFF : (uint8_t)(1 + (rand() % 254));
+        dst[i] = 0xE0E0E0FF;
+    }
+
+    double fixed = bench(blendSpan, dst, coverage);
+    double floating = bench(floatSpan, dst, coverage);
+    printf("blendSpan %.2f ns/px, float %.2f ns/px\n", fixed, floating);
+}
+
+int main(int argc, char **argv)
+{
+    if(!testGolden())
+        return EXIT_FAILURE;
+
+    printf("test_blend: OK\n");
+    if(argc > 1 && strcmp(argv[1], "--bench") == 0)
+        runBench();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,381 @@
+// Host test of the NTP client policies and the on-wire calculation. A fake transport hands the client
+// one end of a socket pair per server, the test answers on the other end while it moves the clock.
+#include "ntpclient.h"
+#include <cstdlib>
+
+static int failures;
+
+#define CHECK(cond) do { if(!(cond)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); ++failures; } } while(0)
+
+#define TICKS_PER_SECOND static_cast<OSTime>(OSSecondsToTicks(1))
+#define MS(ms) static_cast<OSTime>(OSMillisecondsToTicks(ms))
+
+static OSTime hostTime;
+static OSTime setTime;
+
+OSTime OSGetTime(void)
+{
+    return hostTime;
+}
+
+extern "C" int32_t CCRSysSetSystemTime(OSTime time)
+{
+    setTime = time;
+    return 0;
+}
+
+extern "C" bool __OSSetAbsoluteSystemTime(OSTime time)
+{
+    return time == setTime;
+}
+
+struct TestNotifier
+{
+    static int infos;
+    static int errors;
+    static void info(const char *text) { (void)text; ++infos; }
+    static void error(const char *text) { (void)text; ++errors; }
+};
+
+int TestNotifier::infos;
+int TestNotifier::errors;
+
+// Hands out a socket pair per query and remembers which server it stands for
+class FakeTransport
+{
+public:
+    static const uint8_t replyMode = MODE_SERVER;
+    static const bool hasOrigin = true;
+    static const uint32_t timeout = NTP_TIMEOUT;
+
+    static uint32_t servers;
+    static uint32_t server;
+    static int peerFd;
+
+    bool start(const char *name, SYNC_ERRORS *errors)
+    {
+        (void)name;
+        (void)errors;
+        server = 0;
+        return servers != 0;
+    }
+
+    bool hasCandidate() const { return server < servers; }
+    void nextCandidate() { ++server; }
+    const char *peer() const { return "fake"; }
+
+    int send(OSTime *sent, SYNC_ERRORS *errors)
+    {
+        (void)errors;
+        int fds[2];
+        if(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) != 0)
+            return -1;
+
+        if(peerFd != -1)
+            close(peerFd);
+
+        ntp_packet packet;
+        OSBlockSet(&packet, 0, sizeof(packet));
+        packet.li_vn_mode = (1 << 3) | MODE_CLIENT;
+
+        peerFd = fds[1];
+        *sent = OSGetTime();
+        if(write(fds[0], &packet, sizeof(packet)) == sizeof(packet))
+            return fds[0];
+
+        close(fds[0]);
+        return -1;
+    }
+
+    void finish()
+    {
+        if(peerFd != -1)
+            close(peerFd);
+
+        peerFd = -1;
+    }
+};
+
+uint32_t FakeTransport::servers;
+uint32_t FakeTransport::server;
+int FakeTransport::peerFd = -1;
+
+// The inverse of ntpToTicks()
+static uint32_t ntpSeconds(OSTime time)
+{
+    return htonl(static_cast<uint32_t>((time / TICKS_PER_SECOND) + NTP_TIMESTAMP_DELTA));
+}
+
+static uint32_t ntpFraction(OSTime time)
+{
+    return htonl(static_cast<uint32_t>(((time % TICKS_PER_SECOND) << 32) / TICKS_PER_SECOND));
+}
+
+// Answers the query in flight as a server whose clock is serverOffset ahead, with the given one way delays
+template<class Client>
+static void answer(Client *client, OSTime serverOffset, OSTime out, OSTime back, uint8_t stratum)
+{
+    OSTime sent = hostTime;
+    ntp_packet packet;
+    CHECK(read(FakeTransport::peerFd, &packet, sizeof(packet)) == sizeof(packet));
+    CHECK((packet.li_vn_mode & MODE_MASK) == MODE_CLIENT);
+
+    OSBlockSet(&packet, 0, sizeof(packet));
+    packet.li_vn_mode = (4 << 3) | MODE_SERVER;
+    packet.stratum = stratum;
+    packet.rxTm_s = ntpSeconds(sent + out + serverOffset);
+    packet.rxTm_f = ntpFraction(sent + out + serverOffset);
+    packet.txTm_s = ntpSeconds(sent + out + MS(1) + serverOffset);
+    packet.txTm_f = ntpFraction(sent + out + MS(1) + serverOffset);
+    CHECK(write(FakeTransport::peerFd, &packet, sizeof(packet)) == sizeof(packet));
+    hostTime = sent + out + MS(1) + back;
+
+    fd_set readfds;
+    FD_ZERO(&readfds);
+    int maxfd = -1;
+    OSTime wakeup = INT64_MAX;
+    client->prepareFds(&readfds, &maxfd, &wakeup);
+    CHECK(maxfd != -1);
+    CHECK(select(maxfd + 1, &readfds, nullptr, nullptr, nullptr) == 1);
+
+    SYNC_ERRORS errors;
+    errors.count = 0;
+    client->handleFds(&readfds, &errors);
+}
+
+static bool near(OSTime a, OSTime b)
+{
+    OSTime diff = a - b;
+    return diff >= -MS(1) / 1000 && diff <= MS(1) / 1000;
+}
+
+static void testFilters()
+{
+    MinDelayFilter<3> filter;
+    NTP_SAMPLE sample;
+    filter.reset();
+    CHECK(!filter.result(&sample));
+
+    const OSTime delays[] = { 40, 12, 30 };
+    for(uint32_t i = 0; i < 3; ++i)
+    {
+        CHECK(!filter.full());
+        NTP_SAMPLE s = { static_cast<OSTime>(i), delays[i] };
+        filter.add(s);
+    }
+
+    CHECK(filter.full());
+    CHECK(filter.result(&sample) && sample.offset == 1 && sample.delay == 12);
+}
+
+static void testSelection()
+{
+    MedianSelection<3> selection;
+    NTP_SAMPLE sample;
+    selection.reset();
+    CHECK(!selection.result(&sample));
+
+    // One falseticker far ahead must not win
+    const OSTime offsets[] = { 10, 1000000, -3 };
+    for(uint32_t i = 0; i < 3; ++i)
+    {
+        CHECK(!selection.done());
+        NTP_SAMPLE s = { offsets[i], 0 };
+        selection.add(s);
+    }
+
+    CHECK(selection.done());
+    CHECK(selection.result(&sample) && sample.offset == 10);
+
+    // With two of three answering the lower one is taken
+    selection.reset();
+    NTP_SAMPLE a = { 7, 0 };
+    NTP_SAMPLE b = { 5, 0 };
+    selection.add(a);
+    selection.add(b);
+    CHECK(selection.result(&sample) && sample.offset == 5);
+}
+
+// RFC 5905: the offset is off by half the asymmetry of the path, the delay excludes the servers processing time
+static void testOnWire()
+{
+    NtpClient<FakeTransport, NoFilter, FirstSource, StepDiscipline<250>, TestNotifier> client;
+    SYNC_ERRORS errors;
+    errors.count = 0;
+    FakeTransport::servers = 1;
+    hostTime = 1000 * TICKS_PER_SECOND;
+
+    client.start("fake", &errors);
+    client.step(hostTime, &errors);
+    CHECK(client.busy());
+    answer(&client, 5 * TICKS_PER_SECOND, MS(40), MS(60), 1);
+    CHECK(!client.busy());
+    CHECK(client.succeeded());
+
+    OSTime offset = 0;
+    CHECK(client.finish(&offset));
+    CHECK(near(offset, (5 * TICKS_PER_SECOND) - MS(10)));
+    CHECK(errors.count == 0);
+}
+
+static void testMedianOfServers()
+{
+    NtpClient<FakeTransport, MinDelayFilter<2>, MedianSelection<3>, StepDiscipline<250>, TestNotifier> client;
+    SYNC_ERRORS errors;
+    errors.count = 0;
+    FakeTransport::servers = 3;
+    hostTime = 1000 * TICKS_PER_SECOND;
+
+    // Each server is asked twice, the second answer of each has a shorter but lopsided path
+    const OSTime serverOffsets[] = { 2 * TICKS_PER_SECOND, 3600 * TICKS_PER_SECOND, -TICKS_PER_SECOND };
+    client.start("fake", &errors);
+    for(uint32_t i = 0; i < 3; ++i)
+    {
+        client.step(hostTime, &errors);
+        CHECK(FakeTransport::server == i);
+        answer(&client, serverOffsets[i], MS(50), MS(50), 2);
+        client.step(hostTime, &errors);
+        CHECK(FakeTransport::server == i);
+        answer(&client, serverOffsets[i], MS(2), MS(10), 2);
+    }
+
+    CHECK(client.succeeded());
+    OSTime offset = 0;
+    CHECK(client.finish(&offset));
+    CHECK(near(offset, (2 * TICKS_PER_SECOND) - MS(4)));
+}
+
+static void testTimeoutAndInvalid()
+{
+    NtpClient<FakeTransport, NoFilter, FirstSource, StepDiscipline<250>, TestNotifier> client;
+    SYNC_ERRORS errors;
+    errors.count = 0;
+    FakeTransport::servers = 3;
+    hostTime = 1000 * TICKS_PER_SECOND;
+
+    client.start("fake", &errors);
+    client.step(hostTime, &errors);
+
+    // The first server never answers
+    hostTime += MS(NTP_TIMEOUT);
+    client.step(hostTime, &errors);
+    CHECK(errors.count == 1);
+    CHECK(FakeTransport::server == 1);
+
+    // The second one isn't synchronized itself
+    answer(&client, TICKS_PER_SECOND, MS(5), MS(5), 0);
+    CHECK(!client.succeeded());
+    client.step(hostTime, &errors);
+    CHECK(FakeTransport::server == 2);
+
+    answer(&client, TICKS_PER_SECOND, MS(5), MS(5), 3);
+    OSTime offset = 0;
+    CHECK(client.finish(&offset));
+    CHECK(near(offset, TICKS_PER_SECOND));
+}
+
+static void testNothingAnswers()
+{
+    NtpClient<FakeTransport, NoFilter, FirstSource, StepDiscipline<250>, TestNotifier> client;
+    SYNC_ERRORS errors;
+    errors.count = 0;
+    FakeTransport::servers = 0;
+
+    client.start("fake", &errors);
+    client.step(hostTime, &errors);
+    CHECK(!client.busy());
+
+    OSTime offset = 0;
+    CHECK(!client.finish(&offset));
+}
+
+// UDP 123 silently dropped while the HTTP fallback answered: the sync stepping the client with query = false
+// has to see the query in flight time out instead of waiting for it forever, and no new one may start.
+static void testBlockedAfterFallback()
+{
+    NtpClient<FakeTransport, NoFilter, FirstSource, StepDiscipline<250>, TestNotifier> client;
+    SYNC_ERRORS errors;
+    errors.count = 0;
+    FakeTransport::servers = 3;
+    hostTime = 1000 * TICKS_PER_SECOND;
+
+    client.start("fake", &errors);
+    client.step(hostTime, &errors);
+    CHECK(client.busy());
+
+    // HTTP succeeded, the NTP query still has time left
+    hostTime += MS(NTP_TIMEOUT / 2);
+    client.step(hostTime, &errors, false);
+    CHECK(client.busy());
+
+    fd_set readfds;
+    FD_ZERO(&readfds);
+    int maxfd = -1;
+    OSTime wakeup = INT64_MAX;
+    client.prepareFds(&readfds, &maxfd, &wakeup);
+    CHECK(wakeup == 1000 * TICKS_PER_SECOND + MS(NTP_TIMEOUT));
+
+    hostTime = wakeup;
+    client.step(hostTime, &errors, false);
+    CHECK(!client.busy());
+    CHECK(errors.count == 1);
+    CHECK(FakeTransport::server == 1);
+
+    client.step(hostTime, &errors, false);
+    CHECK(!client.busy());
+    CHECK(FakeTransport::server == 1);
+
+    OSTime offset = 0;
+    CHECK(!client.finish(&offset));
+}
+
+// Pool members failing the same way collapse into one error naming the last of them
+static void testErrorKinds()
+{
+    SYNC_ERRORS errors;
+    errors.count = 0;
+    for(uint32_t i = 0; i < 6; ++i)
+        syncError(&errors, "SNTP Client: Timeout reading from %s", i & 1 ? "10.0.0.1" : "10.0.0.2");
+
+    syncError(&errors, "SNTP Client: Got invalid reply from %s!", "10.0.0.3");
+    CHECK(errors.count == 2);
+    CHECK(errors.repeat[0] == 6 && strcmp(errors.msg[0], "SNTP Client: Timeout reading from 10.0.0.1") == 0);
+    CHECK(errors.repeat[1] == 1 && strcmp(errors.msg[1], "SNTP Client: Got invalid reply from 10.0.0.3!") == 0);
+}
+
+static void testStepDiscipline()
+{
+    typedef NtpClient<FakeTransport, NoFilter, FirstSource, StepDiscipline<250>, TestNotifier> Client;
+    hostTime = 1000 * TICKS_PER_SECOND;
+    setTime = 0;
+    TestNotifier::infos = TestNotifier::errors = 0;
+
+    Client::discipline(hostTime - MS(200));
+    CHECK(setTime == 0 && TestNotifier::infos == 0);
+
+    Client::discipline(hostTime + MS(300));
+    CHECK(setTime == hostTime + MS(300) && TestNotifier::infos == 1);
+    CHECK(TestNotifier::errors == 0);
+}
+
+int main()
+{
+    testFilters();
+    testSelection();
+    testOnWire();
+    testMedianOfServers();
+    testTimeoutAndInvalid();
+    testNothingAnswers();
+    testBlockedAfterFallback();
+    testErrorKinds();
+    testStepDiscipline();
+
+    if(failures != 0)
+    {
+        printf("test_ntpclient: %d failures\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("test_ntpclient: OK\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+// Host test of tzrule.c against the host libc. Every zone of tools/zones.txt is parsed from the footer of
+// its TZif file and evaluated next to localtime_r() with the same POSIX TZ string, from 1971 to 2060.
+#define _GNU_SOURCE
+#include "tzrule.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FIRST_TIME 31536000LL   // 1971-01-01
+#define LAST_TIME 2871763200LL  // 2061-01-01
+#define STRIDE (86400 + 3607)   // Drifts through the hours of the day
+#define MAX_REPORTS 3           // Per zone
+
+static int failures;
+static long checks;
+
+// Rules no zone uses right now, but that tzdata allows. Without explicit dates libc takes them from the
+// posixrules file instead of a fixed default, so that case can't be compared here.
+static const char *const extraRules[] = {
+    "AAA3BBB2,J60/2,J300",
+    "AAA-5BBB-6,59/1,300/-3",
+    "AAA+3:15BBB,M2.5.3/167,M12.5.6/-167",
+    "UTC0",
+    "<-0130>1:30<-00>0,M4.5.0,M9.4.6/23:59:59",
+};
+
+static long libcOffset(time_t t)
+{
+    struct tm tm;
+    localtime_r(&t, &tm);
+    return tm.tm_gmtoff;
+}
+
+static void checkRule(const char *name, const char *tz)
+{
+    TzRule rule;
+    if(!tzParse(tz, &rule))
+    {
+        printf("%s: can't parse \"%s\"\n", name, tz);
+        ++failures;
+        return;
+    }
+
+    setenv("TZ", tz, 1);
+    tzset();
+
+    int reports = 0;
+    for(int64_t t = FIRST_TIME; t < LAST_TIME && reports < MAX_REPORTS; t += STRIDE)
+    {
+        int64_t next;
+        int32_t offset = tzOffset(&rule, t, &next);
+        ++checks;
+        if(offset != libcOffset(t))
+        {
+            printf("%s (%s) at %lld: %d, libc %ld\n", name, tz, (long long)t, offset, libcOffset(t));
+            ++reports;
+        }
+
+        if(next == 0)
+            continue;
+
+        // The transition has to be exactly where libc changes the offset
+        int64_t ignored;
+        checks += 2;
+        if(next <= t || tzOffset(&rule, next - 1, &ignored) != libcOffset(next - 1) || tzOffset(&rule, next, &ignored) != libcOffset(next) || libcOffset(next - 1) == libcOffset(next))
+        {
+            printf("%s (%s): wrong transition %lld after %lld\n", name, tz, (long long)next, (long long)t);
+            ++reports;
+        }
+    }
+
+    failures += reports;
+}
+
+// The POSIX TZ string of the last line of a TZif version 2+ file
+static bool readFooter(const char *path, char *out, size_t size)
+{
+    FILE *f = fopen(path, "rb");
+    if(f == NULL)
+        return false;
+
+    static char data[0x20000];
+    size_t len = fread(data, 1, sizeof(data), f);
+    fclose(f);
+    if(len < 5 || memcmp(data, "TZif", 4) != 0 || data[4] < '2' || data[len - 1] != '\n')
+        return false;
+
+    size_t start = len - 1;
+    while(start > 0 && data[start - 1] != '\n')
+        --start;
+    if(len - 1 - start >= size)
+        return false;
+
+    memcpy(out, data + start, len - 1 - start);
+    out[len - 1 - start] = '\0';
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if(argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <zoneinfo> <zones.txt>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for(size_t i = 0; i < sizeof(extraRules) / sizeof(extraRules[0]); ++i)
+        checkRule(extraRules[i], extraRules[i]);
+
+    FILE *zones = fopen(argv[2], "r");
+    if(zones == NULL)
+    {
+        perror(argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    char line[256];
+    char path[512];
+    char tz[128];
+    int count = 0;
+    while(fgets(line, sizeof(line), zones) != NULL)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        if(line[0] == '#' || line[0] == '\0')
+            continue;
+
+        snprintf(path, sizeof(path), "%s/%s", argv[1], line);
+        if(!readFooter(path, tz, sizeof(tz)))
+        {
+            printf("%s: no TZif version 2+ file at %s\n", line, path);
+            ++failures;
+            continue;
+        }
+
+        checkRule(line, tz);
+        ++count;
+    }
+
+    fclose(zones);
+
+    if(failures != 0)
+    {
+        printf("test_tzrule: %d failures\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("test_tzrule: OK, %d zones, %ld checks\n", count, checks);
+    return EXIT_SUCCESS;
+}
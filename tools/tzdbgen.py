@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+# Compiles the timezone database of the plugin (source/tzdb_data.h) from IANA tzdata.
+#
+# Usage: tzdbgen.py [zoneinfo directory] [zone list] [output]
+#
+# The rule of each zone is taken from the POSIX TZ string in the footer of its TZif file and parsed here,
+# so the plugin never has to parse one. Identical rules are stored only once. The indices for the timezone
+# picker are built here, too.
+
+import os
+import sys
+
+ZONEINFO = sys.argv[1] if len(sys.argv) > 1 else '/usr/share/zoneinfo'
+ZONES = sys.argv[2] if len(sys.argv) > 2 else os.path.join(os.path.dirname(__file__), 'zones.txt')
+OUTPUT = sys.argv[3] if len(sys.argv) > 3 else os.path.join(os.path.dirname(__file__), '..', 'source', 'tzdb_data.h')
+
+TZ_DATE_JULIAN = 0
+TZ_DATE_ZERO_BASED = 1
+TZ_DATE_MONTH = 2
+
+
+class Parser:
+    # Same grammar as tzParse() in source/tzrule.c
+
+    def __init__(self, tz):
+        self.tz = tz
+        self.pos = 0
+
+    def peek(self):
+        return self.tz[self.pos] if self.pos < len(self.tz) else ''
+
+    def error(self):
+        raise ValueError('Invalid TZ string: ' + self.tz)
+
+    def number(self, maximum):
+        start = self.pos
+        while self.peek().isdigit():
+            self.pos += 1
+        if start == self.pos or int(self.tz[start:self.pos]) > maximum:
+            self.error()
+        return int(self.tz[start:self.pos])
+
+    def time(self, max_hours):
+        sign = 1
+        if self.peek() in '+-':
+            sign = -1 if self.peek() == '-' else 1
+            self.pos += 1
+        seconds = self.number(max_hours) * 3600
+        if self.peek() == ':':
+            self.pos += 1
+            seconds += self.number(59) * 60
+            if self.peek() == ':':
+                self.pos += 1
+                seconds += self.number(59)
+        return sign * seconds
+
+    def name(self):
+        if self.peek() == '<':
+            end = self.tz.find('>', self.pos)
+            if end == -1:
+                self.error()
+            self.pos = end + 1
+            return
+        start = self.pos
+        while self.peek().isalpha():
+            self.pos += 1
+        if self.pos - start < 3:
+            self.error()
+
+    def date(self):
+        if self.peek() == 'M':
+            self.pos += 1
+            month = self.number(12)
+            if month == 0 or self.peek() != '.':
+                self.error()
+            self.pos += 1
+            week = self.number(5)
+            if week == 0 or self.peek() != '.':
+                self.error()
+            self.pos += 1
+            date = [TZ_DATE_MONTH, month, week, self.number(6), 0]
+        elif self.peek() == 'J':
+            self.pos += 1
+            day = self.number(365)
+            if day == 0:
+                self.error()
+            date = [TZ_DATE_JULIAN, 0, 0, 0, day]
+        else:
+            date = [TZ_DATE_ZERO_BASED, 0, 0, 0, self.number(365)]
+
+        time = 2 * 3600
+        if self.peek() == '/':
+            self.pos += 1
+            time = self.time(167)
+        return tuple(date + [time])
+
+    def parse(self):
+        self.name()
+        std = -self.time(24)
+        if self.peek() == '':
+            return (std, std, False, (0, 0, 0, 0, 0, 0), (0, 0, 0, 0, 0, 0))
+
+        self.name()
+        dst = std + 3600
+        if self.peek() not in (',', ''):
+            dst = -self.time(24)
+        if self.peek() == '':
+            self.tz += ',M3.2.0,M11.1.0'
+        if self.peek() != ',':
+            self.error()
+        self.pos += 1
+        start = self.date()
+        if self.peek() != ',':
+            self.error()
+        self.pos += 1
+        end = self.date()
+        if self.peek() != '':
+            self.error()
+        return (std, dst, True, start, end)
+
+
+def footer(zone):
+    with open(os.path.join(ZONEINFO, zone), 'rb') as f:
+        data = f.read()
+    if data[:4] != b'TZif' or data[4:5] < b'2':
+        raise ValueError(zone + ' is no TZif version 2+ file')
+    return data[data.rstrip(b'\n').rfind(b'\n') + 1:].strip().decode('ascii')
+
+
+def searchKey(name):
+    # Same normalization as searchChar() in source/tzdb.c: only lowercase letters and digits count
+    return ''.join(c.lower() for c in name if c.isalnum())
+
+
+def version():
+    try:
+        with open(os.path.join(ZONEINFO, 'tzdata.zi')) as f:
+            return f.readline().split()[-1]
+    except OSError:
+        return 'unknown'
+
+
+def main():
+    with open(ZONES) as f:
+        zones = [line.strip() for line in f if line.strip() and not line.startswith('#')]
+
+    rules = []
+    ruleIndex = {}
+    names = bytearray()
+    records = []
+    for zone in zones:
+        rule = Parser(footer(zone)).parse()
+        if rule not in ruleIndex:
+            ruleIndex[rule] = len(rules)
+            rules.append(rule)
+        records.append((len(names), ruleIndex[rule]))
+        names += zone.encode('ascii') + b'\0'
+
+    if len(names) > 0xFFFF or len(rules) > 0xFFFF:
+        raise ValueError('Database too big for 16 bit indices')
+
+    order = sorted(range(len(zones)), key=lambda i: zones[i])
+    regions = [pos for pos in range(len(order)) if pos == 0 or zones[order[pos]].split('/')[0] != zones[order[pos - 1]].split('/')[0]]
+    byCity = sorted(range(len(zones)), key=lambda i: (searchKey(zones[i].split('/')[-1]), zones[i]))
+    byName = sorted(range(len(zones)), key=lambda i: (searchKey(zones[i]), zones[i]))
+
+    def table(rows):
+        for i in range(0, len(rows), 16):
+            out.append('    ' + ', '.join(str(z) for z in rows[i:i + 16]) + ',')
+
+    out = []
+    out.append('// Generated by tools/tzdbgen.py from tzdata %s, do not edit.' % version())
+    out.append('#pragma once')
+    out.append('')
+    out.append('#define TZDB_VERSION "%s"' % version())
+    out.append('#define TZDB_ZONE_COUNT %d' % len(zones))
+    out.append('#define TZDB_RULE_COUNT %d' % len(rules))
+    out.append('#define TZDB_REGION_COUNT %d' % len(regions))
+    out.append('#define TZDB_NAME_MAX %d // Longest zone name with its \\0' % (max(len(zone) for zone in zones) + 1))
+    out.append('')
+    out.append('#ifdef TZDB_IMPLEMENTATION')
+    out.append('')
+    out.append('// All zone names, separated by \\0')
+    out.append('static const char tzdbNames[%d] =' % len(names))
+    for i, zone in enumerate(zones):
+        out.append('    "%s\\0"%s' % (zone, ';' if i == len(zones) - 1 else ''))
+    out.append('')
+    out.append('// Offset of the name in tzdbNames and index into tzdbRules, in the order of tools/zones.txt')
+    out.append('static const TzdbZone tzdbZones[TZDB_ZONE_COUNT] = {')
+    for i, (name, rule) in enumerate(records):
+        out.append('    { %d, %d }, // %s' % (name, rule, zones[i]))
+    out.append('};')
+    out.append('')
+    out.append('// Zones sorted by name, for binary searches')
+    out.append('static const uint16_t tzdbSorted[TZDB_ZONE_COUNT] = {')
+    table(order)
+    out.append('};')
+    out.append('')
+    out.append('// Position in tzdbSorted of the first zone of each region (the part of the name before the first /)')
+    out.append('static const uint16_t tzdbRegions[TZDB_REGION_COUNT] = {')
+    table(regions)
+    out.append('};')
+    out.append('')
+    out.append('// Zones sorted by the search key of the city (the part of the name after the last /)')
+    out.append('static const uint16_t tzdbByCity[TZDB_ZONE_COUNT] = {')
+    table(byCity)
+    out.append('};')
+    out.append('')
+    out.append('// Zones sorted by the search key of the whole name')
+    out.append('static const uint16_t tzdbByName[TZDB_ZONE_COUNT] = {')
+    table(byName)
+    out.append('};')
+    out.append('')
+    out.append('static const TzRule tzdbRules[TZDB_RULE_COUNT] = {')
+    for std, dst, hasDst, start, end in rules:
+        out.append('    { %d, %d, %s, { %d, %d, %d, %d, %d, %d }, { %d, %d, %d, %d, %d, %d } },' % ((std, dst, 'true' if hasDst else 'false') + start + end))
+    out.append('};')
+    out.append('')
+    out.append('#endif')
+    out.append('')
+
+    with open(OUTPUT, 'w') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()